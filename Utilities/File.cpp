@@ -251,6 +251,15 @@ namespace fs
 		return {};
 	}
 
+	u64 file_base::write_at(u64 offset, const void* buffer, u64 size)
+	{
+		const u64 old_pos = seek(0, seek_cur);
+		seek(offset, seek_set);
+		const u64 result = write(buffer, size);
+		seek(old_pos, seek_set);
+		return result;
+	}
+
 	u64 file_base::write_gather(const iovec_clone* buffers, u64 buf_count)
 	{
 		u64 total = 0;
@@ -538,6 +547,35 @@ namespace fs
 			return nwritten_sum;
 		}
 
+		u64 write_at(u64 offset, const void* buffer, u64 count) override
+		{
+			u64 nwritten_sum = 0;
+
+			for (const char* data = static_cast<const char*>(buffer); count;)
+			{
+				const DWORD size = static_cast<DWORD>(std::min<u64>(count, DWORD{umax} & -4096));
+
+				DWORD nwritten = 0;
+				OVERLAPPED ovl{};
+				ovl.Offset = DWORD(offset);
+				ovl.OffsetHigh = DWORD(offset >> 32);
+				ensure(WriteFile(m_handle, data, size, &nwritten, &ovl)); // "file::write_at"
+				ensure(nwritten == size);
+				nwritten_sum += nwritten;
+
+				if (nwritten < size)
+				{
+					break;
+				}
+
+				count -= size;
+				data += size;
+				offset += size;
+			}
+
+			return nwritten_sum;
+		}
+
 		u64 seek(s64 offset, seek_mode whence) override
 		{
 			if (whence > seek_end)
@@ -710,6 +748,25 @@ namespace fs
 			return result;
 		}
 
+		u64 write_at(u64 offset, const void* buffer, u64 count) override
+		{
+			u64 result = 0;
+
+			// For safety; see read()
+			while (auto r = ::pwrite(m_fd, buffer, count, offset))
+			{
+				ensure(r > 0); // "file::write_at"
+				count -= r;
+				offset += r;
+				result += r;
+				buffer = static_cast<const u8*>(buffer) + r;
+				if (!count)
+					break;
+			}
+
+			return result;
+		}
+
 		u64 seek(s64 offset, seek_mode whence) override
 		{
 			if (whence > seek_end)
@@ -1852,6 +1909,89 @@ fs::file_id fs::file::get_id() const
 	return {};
 }
 
+fs::file_mapping::file_mapping(const file& f)
+{
+	if (!f)
+	{
+		g_tls_error = error::inval;
+		return;
+	}
+
+	const u64 size = f.size();
+
+	if (!size)
+	{
+		// Empty mappings are not supported
+		g_tls_error = error::inval;
+		return;
+	}
+
+#ifdef _WIN32
+	const HANDLE handle = f.get_handle();
+
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		g_tls_error = error::inval;
+		return;
+	}
+
+	const HANDLE map = CreateFileMappingW(handle, nullptr, PAGE_READONLY, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+
+	if (!map)
+	{
+		g_tls_error = to_error(GetLastError());
+		return;
+	}
+
+	// The view keeps the mapping object alive
+	const auto ptr = MapViewOfFile(map, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(size));
+	const DWORD last_error = GetLastError();
+	CloseHandle(map);
+
+	if (!ptr)
+	{
+		g_tls_error = to_error(last_error);
+		return;
+	}
+#else
+	const int fd = f.get_handle();
+
+	if (fd < 0)
+	{
+		g_tls_error = error::inval;
+		return;
+	}
+
+	const auto ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+	if (ptr == MAP_FAILED)
+	{
+		g_tls_error = to_error(errno);
+		return;
+	}
+#endif
+
+	m_ptr = static_cast<const u8*>(ptr);
+	m_size = size;
+}
+
+void fs::file_mapping::close()
+{
+	if (!m_ptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_ptr);
+#else
+	::munmap(const_cast<u8*>(m_ptr), m_size);
+#endif
+
+	m_ptr = nullptr;
+	m_size = 0;
+}
+
 bool fs::dir::open(const std::string& path)
 {
 	m_dir.reset();
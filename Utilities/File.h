@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <span>
 #include <algorithm>
 
 namespace fs
@@ -109,6 +110,7 @@ namespace fs
 		virtual u64 read(void* buffer, u64 size) = 0;
 		virtual u64 read_at(u64 offset, void* buffer, u64 size) = 0;
 		virtual u64 write(const void* buffer, u64 size) = 0;
+		virtual u64 write_at(u64 offset, const void* buffer, u64 size);
 		virtual u64 seek(s64 offset, seek_mode whence) = 0;
 		virtual u64 size() = 0;
 		virtual native_handle get_handle();
@@ -348,6 +350,13 @@ namespace fs
 			return m_file->write(buffer, count);
 		}
 
+		// Write the data to the file at specified offset, the current position is not changed (thread-safe only for native files)
+		u64 write_at(u64 offset, const void* buffer, u64 count, std::source_location src_loc = std::source_location::current()) const
+		{
+			if (!m_file) xnull(src_loc);
+			return m_file->write_at(offset, buffer, count);
+		}
+
 		// Change current position, returns resulting position
 		u64 seek(s64 offset, seek_mode whence = seek_set, std::source_location src_loc = std::source_location::current()) const
 		{
@@ -490,6 +499,76 @@ namespace fs
 		}
 	};
 
+	// Read-only memory mapping of the whole file contents (native files only)
+	class file_mapping final
+	{
+		const u8* m_ptr = nullptr;
+		u64 m_size = 0;
+
+	public:
+		file_mapping() = default;
+
+		// Map the file at its current size, pages are loaded on access
+		explicit file_mapping(const file& f);
+
+		file_mapping(const file_mapping&) = delete;
+
+		file_mapping& operator=(const file_mapping&) = delete;
+
+		file_mapping(file_mapping&& other) noexcept
+			: m_ptr(std::exchange(other.m_ptr, nullptr))
+			, m_size(std::exchange(other.m_size, 0))
+		{
+		}
+
+		file_mapping& operator=(file_mapping&& other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+				m_ptr = std::exchange(other.m_ptr, nullptr);
+				m_size = std::exchange(other.m_size, 0);
+			}
+
+			return *this;
+		}
+
+		~file_mapping()
+		{
+			close();
+		}
+
+		// Unmap explicitly, invalidating all views
+		void close();
+
+		explicit operator bool() const
+		{
+			return m_ptr != nullptr;
+		}
+
+		const u8* data() const
+		{
+			return m_ptr;
+		}
+
+		u64 size() const
+		{
+			return m_size;
+		}
+
+		// Get typed view at specified offset, empty if out of bounds or misaligned
+		template <typename T> requires (std::is_trivially_copyable_v<T>)
+		std::span<const T> view(u64 offset, usz count) const
+		{
+			if (offset > m_size || count > (m_size - offset) / sizeof(T) || offset % alignof(T))
+			{
+				return {};
+			}
+
+			return {reinterpret_cast<const T*>(m_ptr + offset), count};
+		}
+	};
+
 	class dir final
 	{
 		std::unique_ptr<dir_base> m_dir{};
@@ -501,6 +501,7 @@ namespace llvm
 	class ExecutionEngine;
 	class Module;
 	class StringRef;
+	class MemoryBuffer;
 }
 
 enum class thread_state : u32;
@@ -520,6 +521,9 @@ class jit_compiler final
 	// Disk Space left
 	atomic_t<usz> m_disk_space = umax;
 
+	// Store compiled objects in the shared object bundle (flag 0x4)
+	bool m_use_bundle = false;
+
 public:
 	jit_compiler(const std::unordered_map<std::string, u64>& _link, const std::string& _cpu, u32 flags = 0, std::function<u64(const std::string&)> symbols_cement = {}) noexcept;
 	jit_compiler& operator=(thread_state) noexcept;
@@ -545,6 +549,12 @@ public:
 	// Add object (path to obj file)
 	bool add(const std::string& path);
 
+	// Add object previously read with load()
+	bool add(std::unique_ptr<llvm::MemoryBuffer> object, const std::string& path);
+
+	// Read object (path to obj file, looked up in the object bundle first), thread-safe
+	static std::unique_ptr<llvm::MemoryBuffer> load(const std::string& path);
+
 	// Update global mapping for a single value
 	void update_global_mapping(const std::string& name, u64 addr);
 
@@ -11,6 +11,10 @@
 
 #ifdef __linux__
 #include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "mutex.h"
 #define CAN_OVERCOMMIT
 #endif
 
@@ -20,6 +24,121 @@
 
 LOG_CHANNEL(jit_log, "JIT");
 
+#ifdef __linux__
+// Linux perf jitdump file (see tools/perf/Documentation/jitdump-specification.txt in the kernel tree)
+// Enabled by RPCS3_JITDUMP=<directory>, then: perf record -k 1 ...; perf inject --jit -i perf.data -o perf.jit.data
+static void jit_dump_announce(uptr func, usz size, std::string_view name)
+{
+	struct header_t
+	{
+		u32 magic;
+		u32 version;
+		u32 total_size;
+		u32 elf_mach;
+		u32 pad1;
+		u32 pid;
+		u64 timestamp;
+		u64 flags;
+	};
+
+	struct code_load_t
+	{
+		u32 id;
+		u32 total_size;
+		u64 timestamp;
+		u32 pid;
+		u32 tid;
+		u64 vma;
+		u64 code_addr;
+		u64 code_size;
+		u64 code_index;
+	};
+
+	// Must use the same clock as perf record -k 1
+	static constexpr auto get_timestamp = []() -> u64
+	{
+		::timespec ts{};
+		::clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec * 1'000'000'000ull + ts.tv_nsec;
+	};
+
+	static struct jit_dump_t
+	{
+		shared_mutex mutex;
+		fs::file file;
+		u64 code_index = 0;
+
+		jit_dump_t()
+		{
+			const char* dir = ::getenv("RPCS3_JITDUMP");
+
+			if (!dir)
+			{
+				return;
+			}
+
+			const std::string path = fmt::format("%s/jit-%d.dump", *dir ? dir : "/tmp", ::getpid());
+
+			if (!file.open(path, fs::rewrite + fs::read))
+			{
+				jit_log.error("Failed to create jitdump file '%s' (%s)", path, fs::g_tls_error);
+				return;
+			}
+
+			header_t header{};
+			header.magic = 0x4A695444; // 'JiTD'
+			header.version = 1;
+			header.total_size = sizeof(header_t);
+#if defined(ARCH_X64)
+			header.elf_mach = 62; // EM_X86_64
+#elif defined(ARCH_ARM64)
+			header.elf_mach = 183; // EM_AARCH64
+#endif
+			header.pid = ::getpid();
+			header.timestamp = get_timestamp();
+			file.write(header);
+
+			// perf identifies the dump by an executable mapping of it, which is never released
+			if (::mmap(nullptr, utils::get_page_size(), PROT_READ | PROT_EXEC, MAP_PRIVATE, file.get_handle(), 0) == MAP_FAILED)
+			{
+				jit_log.error("Failed to map jitdump file '%s' (errno=%d)", path, errno);
+				file.close();
+				return;
+			}
+
+			jit_log.notice("Writing jitdump to '%s'", path);
+		}
+	} s_dump;
+
+	if (!s_dump.file)
+	{
+		return;
+	}
+
+	code_load_t record{};
+	record.id = 0; // JIT_CODE_LOAD
+	record.total_size = static_cast<u32>(sizeof(code_load_t) + name.size() + 1 + size);
+	record.timestamp = get_timestamp();
+	record.pid = ::getpid();
+	record.tid = static_cast<u32>(::syscall(SYS_gettid));
+	record.vma = func;
+	record.code_addr = func;
+	record.code_size = size;
+
+	std::string data;
+	data.reserve(record.total_size);
+
+	std::lock_guard lock(s_dump.mutex);
+
+	record.code_index = s_dump.code_index++;
+	data.append(reinterpret_cast<const char*>(&record), sizeof(record));
+	data.append(name);
+	data.push_back('\0');
+	data.append(reinterpret_cast<const char*>(func), size);
+	s_dump.file.write(data);
+}
+#endif
+
 void jit_announce(uptr func, usz size, std::string_view name)
 {
 #ifdef __linux__
@@ -50,6 +169,11 @@ void jit_announce(uptr func, usz size, std::string_view name)
 		return;
 	}
 #endif
+
+	if (size && name.size())
+	{
+		jit_dump_announce(func, size, name);
+	}
 #endif
 
 	if (!size)
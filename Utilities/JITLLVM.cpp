@@ -10,7 +10,10 @@
 #include "util/asm.hpp"
 #include "Crypto/unzip.h"
 
+#include <zstd.h>
+
 #include <charconv>
+#include <chrono>
 
 LOG_CHANNEL(jit_log, "JIT");
 
@@ -394,16 +397,423 @@ struct MemoryManager2 : llvm::RTDyldMemoryManager
 	}
 };
 
+// Store of zstd compressed objects shared by all titles, indexed by object name
+// Object names are derived from module content hashes, so identical modules are stored once
+// Records are appended, removed records and objects unused for a while are dropped by compaction when the file is opened
+// The file is locked while open, other processes fall back to loose object files
+class object_bundle
+{
+	struct record_header
+	{
+		u32 magic;
+		u32 name_size;
+		u64 raw_size;
+		u64 data_size; // 0 for a removal record
+		s64 used_time; // Seconds since epoch, updated at most once per c_touch_interval
+	};
+
+	static constexpr u32 c_magic = 0x324f5052; // "RPO2"
+
+	static constexpr s64 c_touch_interval = 24 * 3600;
+	static constexpr s64 c_max_unused_time = 90 * 24 * 3600;
+
+	struct entry
+	{
+		u64 pos; // Record header offset
+		u64 offset; // Compressed data offset
+		u64 data_size;
+		u64 raw_size;
+		s64 used_time;
+
+		u64 record_size() const
+		{
+			return offset - pos + data_size;
+		}
+	};
+
+	shared_mutex m_mutex;
+	fs::file m_file;
+	std::unordered_map<std::string, entry> m_index;
+	u64 m_end = 0;
+	u64 m_dead = 0; // Bytes of superseded, removed and removal records
+	bool m_opened = false;
+
+	static s64 get_time()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	// Open and index the file (call under exclusive lock)
+	void open(bool create)
+	{
+		if (m_file || (m_opened && !create))
+		{
+			return;
+		}
+
+		m_opened = true;
+
+		const std::string path = fs::get_cache_dir() + "cache/ppu_objects.bundle";
+
+		if (!create && !fs::is_file(path))
+		{
+			return;
+		}
+
+		if (!m_file.open(path, fs::read + fs::write + fs::create + fs::lock))
+		{
+			if (fs::g_tls_error == fs::error::acces)
+			{
+				jit_log.warning("LLVM: Object bundle is in use by another process: %s", path);
+			}
+			else
+			{
+				jit_log.error("LLVM: Failed to open object bundle: %s (%s)", path, fs::g_tls_error);
+			}
+
+			return;
+		}
+
+		const u64 size = m_file.size();
+		u64 pos = 0;
+
+		record_header header{};
+		std::string name;
+
+		// Stop at the first incomplete record (interrupted write)
+		while (m_file.read_at(pos, &header, sizeof(header)) == sizeof(header))
+		{
+			const u64 data_pos = pos + sizeof(header) + header.name_size;
+
+			if (header.magic != c_magic || header.name_size > 4096 || data_pos > size || header.data_size > size - data_pos)
+			{
+				break;
+			}
+
+			name.resize(header.name_size);
+
+			if (m_file.read_at(pos + sizeof(header), name.data(), name.size()) != name.size())
+			{
+				break;
+			}
+
+			if (const auto found = m_index.find(name); found != m_index.end())
+			{
+				m_dead += found->second.record_size();
+				m_index.erase(found);
+			}
+
+			if (header.data_size)
+			{
+				m_index.emplace(name, entry{pos, data_pos, header.data_size, header.raw_size, header.used_time});
+			}
+			else
+			{
+				m_dead += data_pos - pos;
+			}
+
+			pos = data_pos + header.data_size;
+		}
+
+		if (pos != size)
+		{
+			jit_log.warning("LLVM: Truncating damaged object bundle at 0x%x (size=0x%x)", pos, size);
+			m_file.trunc(pos);
+		}
+
+		m_end = pos;
+
+		const s64 now = get_time();
+		usz unused = 0;
+
+		for (auto it = m_index.begin(); it != m_index.end();)
+		{
+			if (now - it->second.used_time > c_max_unused_time)
+			{
+				m_dead += it->second.record_size();
+				it = m_index.erase(it);
+				unused++;
+				continue;
+			}
+
+			++it;
+		}
+
+		// Unused objects are not recorded as removed, so compaction must drop them now
+		if (unused || m_dead > m_end / 2)
+		{
+			compact();
+		}
+
+		jit_log.notice("LLVM: Opened object bundle with %u objects (%u unused objects dropped)", m_index.size(), unused);
+	}
+
+	// Move live records to the front and truncate the file (call under exclusive lock)
+	// An interrupted compaction leaves damaged records, which are dropped on open or when loaded
+	void compact()
+	{
+		std::vector<entry*> entries;
+		entries.reserve(m_index.size());
+
+		for (auto& [name, e] : m_index)
+		{
+			entries.push_back(&e);
+		}
+
+		std::sort(entries.begin(), entries.end(), FN(x->pos < y->pos));
+
+		std::vector<u8> buf(1024 * 1024);
+		u64 dst = 0;
+
+		for (entry* e : entries)
+		{
+			const u64 record_size = e->record_size();
+
+			// Records only move backwards, copying in ascending order never overwrites unread data
+			for (u64 done = 0; e->pos != dst && done < record_size;)
+			{
+				const u64 count = std::min<u64>(buf.size(), record_size - done);
+
+				if (m_file.read_at(e->pos + done, buf.data(), count) != count || m_file.write_at(dst + done, buf.data(), count) != count)
+				{
+					jit_log.error("LLVM: Failed to compact object bundle (%s)", fs::g_tls_error);
+					m_file.close();
+					m_index.clear();
+					return;
+				}
+
+				done += count;
+			}
+
+			e->offset = e->offset - e->pos + dst;
+			e->pos = dst;
+			dst += record_size;
+		}
+
+		jit_log.notice("LLVM: Compacted object bundle (0x%x -> 0x%x bytes)", m_end, dst);
+		m_file.trunc(dst);
+		m_end = dst;
+		m_dead = 0;
+	}
+
+	// Append a removal record (call under exclusive lock)
+	void remove_locked(const std::string& name)
+	{
+		const auto found = m_index.find(name);
+
+		if (found == m_index.end())
+		{
+			return;
+		}
+
+		const record_header header{c_magic, ::size32(name), 0, 0, get_time()};
+
+		if (m_file.write_at(m_end, &header, sizeof(header)) != sizeof(header) || m_file.write_at(m_end + sizeof(header), name.data(), name.size()) != name.size())
+		{
+			jit_log.error("LLVM: Failed to remove object %s from bundle (%s)", name, fs::g_tls_error);
+			m_file.trunc(m_end);
+		}
+		else
+		{
+			m_end += sizeof(header) + name.size();
+			m_dead += sizeof(header) + name.size();
+		}
+
+		// Forget it for this session anyway
+		m_dead += found->second.record_size();
+		m_index.erase(found);
+	}
+
+	// Update the usage time of an object (call under exclusive lock)
+	void touch_locked(const std::string& name, s64 now)
+	{
+		const auto found = m_index.find(name);
+
+		if (found == m_index.end() || now - found->second.used_time < c_touch_interval)
+		{
+			return;
+		}
+
+		found->second.used_time = now;
+		m_file.write_at(found->second.pos + offsetof(record_header, used_time), &now, sizeof(now));
+	}
+
+	bool ensure_open(bool create)
+	{
+		{
+			reader_lock lock(m_mutex);
+
+			if (m_file || (m_opened && !create))
+			{
+				return !!m_file;
+			}
+		}
+
+		std::lock_guard lock(m_mutex);
+		open(create);
+		return !!m_file;
+	}
+
+public:
+	static object_bundle& get()
+	{
+		static object_bundle s_bundle;
+		return s_bundle;
+	}
+
+	bool contains(const std::string& name)
+	{
+		if (!ensure_open(false))
+		{
+			return false;
+		}
+
+		reader_lock lock(m_mutex);
+		return m_index.contains(name);
+	}
+
+	// Drop an object, e.g. a damaged one, so that it is compiled again
+	void remove(const std::string& name)
+	{
+		if (!ensure_open(false))
+		{
+			return;
+		}
+
+		std::lock_guard lock(m_mutex);
+
+		if (m_file)
+		{
+			remove_locked(name);
+		}
+	}
+
+	// Returns compressed size, 0 on failure
+	usz store(const std::string& name, const void* data, usz size)
+	{
+		if (!ensure_open(true))
+		{
+			return 0;
+		}
+
+		std::vector<u8> zdata(::ZSTD_compressBound(size));
+
+		ZSTD_CCtx* const ctx = ::ZSTD_createCCtx();
+		::ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, 3);
+		::ZSTD_CCtx_setParameter(ctx, ZSTD_c_checksumFlag, 1);
+		const usz zsize = ::ZSTD_compress2(ctx, zdata.data(), zdata.size(), data, size);
+		::ZSTD_freeCCtx(ctx);
+
+		if (::ZSTD_isError(zsize))
+		{
+			jit_log.error("LLVM: Failed to compress object %s (%s)", name, ::ZSTD_getErrorName(zsize));
+			return 0;
+		}
+
+		const s64 now = get_time();
+		const record_header header{c_magic, ::size32(name), size, zsize, now};
+
+		std::lock_guard lock(m_mutex);
+
+		if (!m_file)
+		{
+			// Closed after a failed compaction
+			return 0;
+		}
+
+		if (m_index.contains(name))
+		{
+			// Deduplicated
+			touch_locked(name, now);
+			return zsize;
+		}
+
+		m_file.seek(m_end);
+
+		if (m_file.write(&header, sizeof(header)) != sizeof(header) || m_file.write(name.data(), name.size()) != name.size() || m_file.write(zdata.data(), zsize) != zsize)
+		{
+			jit_log.error("LLVM: Failed to write object %s to bundle (%s)", name, fs::g_tls_error);
+			m_file.trunc(m_end);
+			return 0;
+		}
+
+		const u64 data_pos = m_end + sizeof(header) + name.size();
+		m_index.emplace(name, entry{m_end, data_pos, zsize, size, now});
+		m_end = data_pos + zsize;
+		return zsize;
+	}
+
+	std::unique_ptr<llvm::MemoryBuffer> load(const std::string& name)
+	{
+		if (!ensure_open(false))
+		{
+			return nullptr;
+		}
+
+		const s64 now = get_time();
+
+		std::vector<u8> zdata;
+		u64 raw_size = 0;
+		bool touch = false;
+		{
+			reader_lock lock(m_mutex);
+
+			const auto found = m_index.find(name);
+
+			if (found == m_index.end())
+			{
+				return nullptr;
+			}
+
+			zdata.resize(found->second.data_size);
+			raw_size = found->second.raw_size;
+			touch = now - found->second.used_time >= c_touch_interval;
+
+			if (m_file.read_at(found->second.offset, zdata.data(), zdata.size()) != zdata.size())
+			{
+				jit_log.error("LLVM: Failed to read object %s from bundle (%s)", name, fs::g_tls_error);
+				return nullptr;
+			}
+		}
+
+		// Decompress directly into the buffer owned by LLVM
+		auto buf = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(raw_size);
+		const usz res = ::ZSTD_decompress(buf->getBufferStart(), buf->getBufferSize(), zdata.data(), zdata.size());
+
+		if (::ZSTD_isError(res) || res != raw_size)
+		{
+			jit_log.error("LLVM: Removed damaged object %s from bundle (%s)", name, ::ZSTD_isError(res) ? ::ZSTD_getErrorName(res) : "size mismatch");
+			remove(name);
+			return nullptr;
+		}
+
+		if (touch)
+		{
+			std::lock_guard lock(m_mutex);
+			touch_locked(name, now);
+		}
+
+		return buf;
+	}
+};
+
+static std::string get_object_name(const std::string& path)
+{
+	return path.substr(path.find_last_of('/') + 1);
+}
+
 // Helper class
 class ObjectCache final : public llvm::ObjectCache
 {
 	const std::string& m_path;
 	const std::add_pointer_t<jit_compiler> m_compiler = nullptr;
+	const bool m_use_bundle = false;
 
 public:
-	ObjectCache(const std::string& path, jit_compiler* compiler = nullptr)
+	ObjectCache(const std::string& path, jit_compiler* compiler = nullptr, bool use_bundle = false)
 		: m_path(path)
 		, m_compiler(compiler)
+		, m_use_bundle(use_bundle)
 	{
 	}
 
@@ -415,7 +825,6 @@ public:
 
 		name.append(_module->getName());
 		//fs::file(name, fs::rewrite).write(obj.getBufferStart(), obj.getBufferSize());
-		name.append(".gz");
 
 		if (!obj.getBufferSize())
 		{
@@ -425,6 +834,27 @@ public:
 
 		ensure(m_compiler);
 
+		if (m_use_bundle)
+		{
+			if (!m_compiler->add_sub_disk_space(0 - obj.getBufferSize()))
+			{
+				jit_log.error("LLVM: Failed to store module: %s (not enough disk space left)", name);
+				return;
+			}
+
+			if (const usz zsize = object_bundle::get().store(get_object_name(name), obj.getBufferStart(), obj.getBufferSize()))
+			{
+				jit_log.trace("LLVM: Stored module in bundle: %s", std::string(_module->getName()));
+				ensure(m_compiler->add_sub_disk_space(obj.getBufferSize() - zsize));
+				return;
+			}
+
+			// Fallback to loose file
+			ensure(m_compiler->add_sub_disk_space(obj.getBufferSize()));
+		}
+
+		name.append(".gz");
+
 		fs::pending_file module_file;
 
 		if (!module_file.open((name)))
@@ -457,6 +887,11 @@ public:
 
 	static std::unique_ptr<llvm::MemoryBuffer> load(const std::string& path)
 	{
+		if (auto buf = object_bundle::get().load(get_object_name(path)))
+		{
+			return buf;
+		}
+
 		if (fs::file cached{path + ".gz", fs::read})
 		{
 			const std::vector<u8> cached_data = cached.to_vector<u8>();
@@ -642,6 +1077,7 @@ bool jit_compiler::add_sub_disk_space(ssz space)
 jit_compiler::jit_compiler(const std::unordered_map<std::string, u64>& _link, const std::string& _cpu, u32 flags, std::function<u64(const std::string&)> symbols_cement) noexcept
 	: m_context(new llvm::LLVMContext)
 	, m_cpu(cpu(_cpu))
+	, m_use_bundle(!!(flags & 0x4))
 {
 	[[maybe_unused]] static const bool s_install_llvm_error_handler = []()
 	{
@@ -773,7 +1209,7 @@ jit_compiler::~jit_compiler() noexcept
 
 void jit_compiler::add(std::unique_ptr<llvm::Module> _module, const std::string& path)
 {
-	ObjectCache cache{path, this};
+	ObjectCache cache{path, this, m_use_bundle};
 	m_engine->setObjectCache(&cache);
 
 	const auto ptr = _module.get();
@@ -803,8 +1239,16 @@ void jit_compiler::add(std::unique_ptr<llvm::Module> _module)
 
 bool jit_compiler::add(const std::string& path)
 {
-	auto cache = ObjectCache::load(path);
+	return add(load(path), path);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> jit_compiler::load(const std::string& path)
+{
+	return ObjectCache::load(path);
+}
 
+bool jit_compiler::add(std::unique_ptr<llvm::MemoryBuffer> cache, const std::string& path)
+{
 	if (!cache)
 	{
 		jit_log.error("ObjectCache: Failed to read file. (path='%s', error=%s)", path, fs::g_tls_error);
@@ -826,6 +1270,23 @@ bool jit_compiler::add(const std::string& path)
 
 bool jit_compiler::check(const std::string& path)
 {
+	const std::string name = get_object_name(path);
+
+	if (object_bundle::get().contains(name))
+	{
+		// Frames are checksummed, load() removes damaged records
+		if (auto cache = object_bundle::get().load(name))
+		{
+			if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
+			{
+				return true;
+			}
+
+			object_bundle::get().remove(name);
+			jit_log.error("ObjectCache: Removed damaged object from bundle: %s", name);
+		}
+	}
+
 	if (auto cache = ObjectCache::load(path))
 	{
 		if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
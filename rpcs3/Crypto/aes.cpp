@@ -772,6 +772,11 @@ int aes_crypt_cbc( aes_context *ctx,
 
     if( mode == AES_DECRYPT )
     {
+#if defined(__SSE2__) || defined(_M_X64)
+        if( aesni_supports( POLARSSL_AESNI_AES ) )
+            return( aesni_decrypt_cbc( ctx, length / 16, iv, input, output ) );
+#endif
+
         while( length > 0 )
         {
             memcpy( temp, input, 16 );
@@ -866,6 +871,17 @@ int aes_crypt_ctr( aes_context *ctx,
     int c, i;
     size_t n = *nc_off;
 
+    if( n == 0 && length >= 16 )
+    {
+        const size_t blocks = length / 16;
+
+        aes_crypt_ctr_blocks( ctx, blocks, nonce_counter, input, output );
+
+        input  += blocks * 16;
+        output += blocks * 16;
+        length -= blocks * 16;
+    }
+
     while( length-- )
     {
         if( n == 0 ) {
@@ -886,6 +902,41 @@ int aes_crypt_ctr( aes_context *ctx,
     return( 0 );
 }
 
+/*
+ * AES-CTR encryption/decryption of whole blocks
+ */
+int aes_crypt_ctr_blocks( aes_context *ctx,
+                          size_t blocks,
+                          unsigned char nonce_counter[16],
+                          const unsigned char *input,
+                          unsigned char *output )
+{
+    unsigned char stream_block[16];
+    int i;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    if( aesni_supports( POLARSSL_AESNI_AES ) )
+        return( aesni_crypt_ctr( ctx, blocks, nonce_counter, input, output ) );
+#endif
+
+    while( blocks-- )
+    {
+        aes_crypt_ecb( ctx, AES_ENCRYPT, nonce_counter, stream_block );
+
+        for( i = 16; i > 0; i-- )
+            if( ++nonce_counter[i - 1] != 0 )
+                break;
+
+        for( i = 0; i < 16; i++ )
+            output[i] = static_cast<unsigned char>( input[i] ^ stream_block[i] );
+
+        input  += 16;
+        output += 16;
+    }
+
+    return( 0 );
+}
+
 /* AES-CMAC */
 
 unsigned char const_Rb[16] = {
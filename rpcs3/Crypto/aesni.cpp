@@ -37,6 +37,20 @@
 #include <intrin.h>
 #endif
 
+#include "util/sysinfo.hpp"
+
+#include <immintrin.h>
+#include <bit>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#define AESNI_FUNC
+#define VAES_FUNC
+#else
+#define AESNI_FUNC __attribute__((__target__("sse2,aes")))
+#define VAES_FUNC __attribute__((__target__("avx512f,aes,vaes")))
+#endif
+
 /*
  * AES-NI support detection routine
  */
@@ -131,6 +145,203 @@ int aesni_crypt_ecb( aes_context *ctx,
     return( 0 );
 }
 
+/*
+ * Number of blocks processed in parallel, enough to hide the latency of AESENC
+ */
+#define AESNI_PARALLEL 8
+#define VAES_PARALLEL 16
+
+/*
+ * Counter block from the 128-bit big-endian counter value
+ */
+AESNI_FUNC static inline __m128i aesni_ctr_block( uint64_t hi, uint64_t lo )
+{
+    return( _mm_set_epi64x( static_cast<long long>( std::byteswap( lo ) ),
+                            static_cast<long long>( std::byteswap( hi ) ) ) );
+}
+
+AESNI_FUNC static void aesni_ctr_blocks( const __m128i *rk, int nr, uint64_t *hi, uint64_t *lo,
+                                         size_t blocks, const unsigned char *input, unsigned char *output )
+{
+    while( blocks )
+    {
+        const size_t n = blocks < AESNI_PARALLEL ? blocks : AESNI_PARALLEL;
+        __m128i b[AESNI_PARALLEL];
+        uint64_t h = *hi, l = *lo;
+        int i, j;
+
+        const __m128i k0 = _mm_loadu_si128( rk );
+
+        for( j = 0; j < AESNI_PARALLEL; j++ )
+        {
+            b[j] = _mm_xor_si128( aesni_ctr_block( h, l ), k0 );
+            h += ( ++l == 0 );
+        }
+
+        for( i = 1; i < nr; i++ )
+        {
+            const __m128i k = _mm_loadu_si128( rk + i );
+
+            for( j = 0; j < AESNI_PARALLEL; j++ )
+                b[j] = _mm_aesenc_si128( b[j], k );
+        }
+
+        const __m128i kl = _mm_loadu_si128( rk + nr );
+
+        for( j = 0; j < AESNI_PARALLEL; j++ )
+            b[j] = _mm_aesenclast_si128( b[j], kl );
+
+        for( j = 0; j < static_cast<int>( n ); j++ )
+        {
+            const __m128i x = _mm_loadu_si128( reinterpret_cast<const __m128i*>( input ) + j );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( output ) + j, _mm_xor_si128( x, b[j] ) );
+        }
+
+        *lo += n;
+        *hi += ( *lo < n );
+
+        input  += n * 16;
+        output += n * 16;
+        blocks -= n;
+    }
+}
+
+VAES_FUNC static size_t vaes_ctr_blocks( const __m128i *rk, int nr, uint64_t *hi, uint64_t *lo,
+                                         size_t blocks, const unsigned char *input, unsigned char *output )
+{
+    const size_t total = blocks - blocks % VAES_PARALLEL;
+
+    for( size_t done = 0; done < total; done += VAES_PARALLEL )
+    {
+        uint64_t c[VAES_PARALLEL * 2];
+        __m512i b[VAES_PARALLEL / 4];
+        int i, j;
+
+        for( j = 0; j < VAES_PARALLEL; j++ )
+        {
+            c[j * 2 + 0] = std::byteswap( *hi );
+            c[j * 2 + 1] = std::byteswap( *lo );
+            *hi += ( ++*lo == 0 );
+        }
+
+        const __m512i k0 = _mm512_broadcast_i32x4( _mm_loadu_si128( rk ) );
+
+        for( j = 0; j < VAES_PARALLEL / 4; j++ )
+            b[j] = _mm512_xor_si512( _mm512_loadu_si512( c + j * 8 ), k0 );
+
+        for( i = 1; i < nr; i++ )
+        {
+            const __m512i k = _mm512_broadcast_i32x4( _mm_loadu_si128( rk + i ) );
+
+            for( j = 0; j < VAES_PARALLEL / 4; j++ )
+                b[j] = _mm512_aesenc_epi128( b[j], k );
+        }
+
+        const __m512i kl = _mm512_broadcast_i32x4( _mm_loadu_si128( rk + nr ) );
+
+        for( j = 0; j < VAES_PARALLEL / 4; j++ )
+        {
+            b[j] = _mm512_aesenclast_epi128( b[j], kl );
+            b[j] = _mm512_xor_si512( b[j], _mm512_loadu_si512( input + done * 16 + j * 64 ) );
+            _mm512_storeu_si512( output + done * 16 + j * 64, b[j] );
+        }
+    }
+
+    return( total );
+}
+
+/*
+ * AES-NI AES-CTR encryption/decryption of whole blocks
+ */
+int aesni_crypt_ctr( aes_context *ctx,
+                     size_t blocks,
+                     unsigned char nonce_counter[16],
+                     const unsigned char *input,
+                     unsigned char *output )
+{
+    const __m128i *rk = reinterpret_cast<const __m128i*>( ctx->rk );
+    uint64_t hi, lo;
+
+    std::memcpy( &hi, nonce_counter + 0, 8 );
+    std::memcpy( &lo, nonce_counter + 8, 8 );
+    hi = std::byteswap( hi );
+    lo = std::byteswap( lo );
+
+    if( blocks >= VAES_PARALLEL && utils::has_avx512_icl() )
+    {
+        const size_t done = vaes_ctr_blocks( rk, ctx->nr, &hi, &lo, blocks, input, output );
+
+        input  += done * 16;
+        output += done * 16;
+        blocks -= done;
+    }
+
+    aesni_ctr_blocks( rk, ctx->nr, &hi, &lo, blocks, input, output );
+
+    hi = std::byteswap( hi );
+    lo = std::byteswap( lo );
+    std::memcpy( nonce_counter + 0, &hi, 8 );
+    std::memcpy( nonce_counter + 8, &lo, 8 );
+
+    return( 0 );
+}
+
+/*
+ * AES-NI AES-CBC decryption of whole blocks
+ */
+AESNI_FUNC int aesni_decrypt_cbc( aes_context *ctx,
+                                  size_t blocks,
+                                  unsigned char iv[16],
+                                  const unsigned char *input,
+                                  unsigned char *output )
+{
+    const __m128i *rk = reinterpret_cast<const __m128i*>( ctx->rk );
+    const int nr = ctx->nr;
+    __m128i prev = _mm_loadu_si128( reinterpret_cast<const __m128i*>( iv ) );
+
+    while( blocks )
+    {
+        const int n = static_cast<int>( blocks < AESNI_PARALLEL ? blocks : AESNI_PARALLEL );
+        __m128i c[AESNI_PARALLEL], b[AESNI_PARALLEL];
+        int i, j;
+
+        // Keep ciphertext for chaining (output may overlap input)
+        for( j = 0; j < n; j++ )
+            c[j] = _mm_loadu_si128( reinterpret_cast<const __m128i*>( input ) + j );
+
+        const __m128i k0 = _mm_loadu_si128( rk );
+
+        for( j = 0; j < n; j++ )
+            b[j] = _mm_xor_si128( c[j], k0 );
+
+        for( i = 1; i < nr; i++ )
+        {
+            const __m128i k = _mm_loadu_si128( rk + i );
+
+            for( j = 0; j < n; j++ )
+                b[j] = _mm_aesdec_si128( b[j], k );
+        }
+
+        const __m128i kl = _mm_loadu_si128( rk + nr );
+
+        for( j = 0; j < n; j++ )
+        {
+            b[j] = _mm_xor_si128( _mm_aesdeclast_si128( b[j], kl ), j ? c[j - 1] : prev );
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( output ) + j, b[j] );
+        }
+
+        prev = c[n - 1];
+
+        input  += n * 16;
+        output += n * 16;
+        blocks -= n;
+    }
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( iv ), prev );
+
+    return( 0 );
+}
+
 #if defined(POLARSSL_HAVE_MSVC_X64_INTRINSICS)
 static inline void clmul256( __m128i a, __m128i b, __m128i* r0, __m128i* r1 )
 {
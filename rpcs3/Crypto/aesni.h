@@ -61,6 +61,41 @@ int aesni_crypt_ecb( aes_context *ctx,
                      const unsigned char input[16],
                      unsigned char output[16] );
 
+/**
+ * \brief          AES-NI AES-CTR encryption/decryption of whole blocks
+ *                 (8 blocks interleaved, 16 with VAES on AVX-512 hosts)
+ *
+ * \param ctx      AES context initialized with aes_setkey_enc()
+ * \param blocks   Number of 16-byte blocks
+ * \param nonce_counter The 128-bit big-endian counter (updated after use)
+ * \param input    Input blocks
+ * \param output   Output blocks (may be equal to input)
+ *
+ * \return         0 on success (cannot fail)
+ */
+int aesni_crypt_ctr( aes_context *ctx,
+                     size_t blocks,
+                     unsigned char nonce_counter[16],
+                     const unsigned char *input,
+                     unsigned char *output );
+
+/**
+ * \brief          AES-NI AES-CBC decryption of whole blocks (8 blocks interleaved)
+ *
+ * \param ctx      AES context initialized with aes_setkey_dec()
+ * \param blocks   Number of 16-byte blocks
+ * \param iv       Initialization vector (updated after use)
+ * \param input    Input blocks
+ * \param output   Output blocks (may be equal to input)
+ *
+ * \return         0 on success (cannot fail)
+ */
+int aesni_decrypt_cbc( aes_context *ctx,
+                       size_t blocks,
+                       unsigned char iv[16],
+                       const unsigned char *input,
+                       unsigned char *output );
+
 /**
  * \brief          GCM multiplication: c = a * b in GF(2^128)
  *
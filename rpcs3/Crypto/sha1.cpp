@@ -31,6 +31,20 @@
 #include "sha1.h"
 #include "utils.h"
 
+#include "util/sysinfo.hpp"
+
+#if defined(ARCH_X64)
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#define SHANI_FUNC
+#define AVX2_FUNC
+#else
+#define SHANI_FUNC __attribute__((__target__("sse4.1,sha")))
+#define AVX2_FUNC __attribute__((__target__("avx2")))
+#endif
+#endif
+
 /*
  * 32-bit integer manipulation macros (big endian)
  */
@@ -69,10 +83,215 @@ void sha1_starts( sha1_context *ctx )
     ctx->state[4] = 0xC3D2E1F0;
 }
 
+#if defined(ARCH_X64)
+/*
+ * SHA-NI compression of consecutive blocks
+ *
+ * Message schedule: M[g] = sha1msg2( sha1msg1( M[g-4], M[g-3] ) ^ M[g-2], M[g-1] )
+ */
+SHANI_FUNC static void sha1_process_shani( uint32_t state[5], const unsigned char *data, size_t blocks )
+{
+    const __m128i mask = _mm_set_epi64x( 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL );
+    __m128i abcd = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( state ) ), 0x1B );
+    __m128i e0 = _mm_set_epi32( static_cast<int>( state[4] ), 0, 0, 0 );
+    __m128i m[20], e, prev;
+    int g;
+
+    for( ; blocks; blocks--, data += 64 )
+    {
+        const __m128i abcd_save = abcd;
+        const __m128i e0_save = e0;
+
+        for( g = 0; g < 4; g++ )
+            m[g] = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>( data ) + g ), mask );
+
+        for( g = 4; g < 20; g++ )
+            m[g] = _mm_sha1msg2_epu32( _mm_xor_si128( _mm_sha1msg1_epu32( m[g - 4], m[g - 3] ), m[g - 2] ), m[g - 1] );
+
+        // Rounds 0-3
+        e = _mm_add_epi32( e0, m[0] );
+        prev = abcd;
+        abcd = _mm_sha1rnds4_epu32( abcd, e, 0 );
+
+        // Rounds 4-79 (the function selector must be an immediate)
+        for( g = 1; g < 5; g++ )
+        {
+            e = _mm_sha1nexte_epu32( prev, m[g] );
+            prev = abcd;
+            abcd = _mm_sha1rnds4_epu32( abcd, e, 0 );
+        }
+
+        for( g = 5; g < 10; g++ )
+        {
+            e = _mm_sha1nexte_epu32( prev, m[g] );
+            prev = abcd;
+            abcd = _mm_sha1rnds4_epu32( abcd, e, 1 );
+        }
+
+        for( g = 10; g < 15; g++ )
+        {
+            e = _mm_sha1nexte_epu32( prev, m[g] );
+            prev = abcd;
+            abcd = _mm_sha1rnds4_epu32( abcd, e, 2 );
+        }
+
+        for( g = 15; g < 20; g++ )
+        {
+            e = _mm_sha1nexte_epu32( prev, m[g] );
+            prev = abcd;
+            abcd = _mm_sha1rnds4_epu32( abcd, e, 3 );
+        }
+
+        e0 = _mm_sha1nexte_epu32( prev, e0_save );
+        abcd = _mm_add_epi32( abcd, abcd_save );
+    }
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( state ), _mm_shuffle_epi32( abcd, 0x1B ) );
+    state[4] = static_cast<uint32_t>( _mm_extract_epi32( e0, 3 ) );
+}
+
+AVX2_FUNC static inline __m256i sha1_rol_x8( __m256i x, int n )
+{
+    return( _mm256_or_si256( _mm256_slli_epi32( x, n ), _mm256_srli_epi32( x, 32 - n ) ) );
+}
+
+/*
+ * AVX2 compression of one block for each of 8 independent messages (one per 32-bit lane)
+ */
+AVX2_FUNC static void sha1_process_x8( __m256i state[5], const unsigned char *const data[8] )
+{
+    alignas(32) uint32_t words[16][8];
+    __m256i W[16], A, B, C, D, E, F, K, temp;
+    int t, l;
+
+    for( t = 0; t < 16; t++ )
+    {
+        for( l = 0; l < 8; l++ )
+            GET_UINT32_BE( words[t][l], data[l], t * 4 );
+
+        W[t] = _mm256_load_si256( reinterpret_cast<const __m256i*>( words[t] ) );
+    }
+
+    A = state[0];
+    B = state[1];
+    C = state[2];
+    D = state[3];
+    E = state[4];
+
+    for( t = 0; t < 80; t++ )
+    {
+        if( t >= 16 )
+        {
+            W[t & 15] = sha1_rol_x8( _mm256_xor_si256( _mm256_xor_si256( W[( t - 3 ) & 15], W[( t - 8 ) & 15] ),
+                                                       _mm256_xor_si256( W[( t - 14 ) & 15], W[t & 15] ) ), 1 );
+        }
+
+        if( t < 20 )
+        {
+            F = _mm256_xor_si256( D, _mm256_and_si256( B, _mm256_xor_si256( C, D ) ) );
+            K = _mm256_set1_epi32( 0x5A827999 );
+        }
+        else if( t < 40 )
+        {
+            F = _mm256_xor_si256( B, _mm256_xor_si256( C, D ) );
+            K = _mm256_set1_epi32( 0x6ED9EBA1 );
+        }
+        else if( t < 60 )
+        {
+            F = _mm256_or_si256( _mm256_and_si256( B, C ), _mm256_and_si256( D, _mm256_or_si256( B, C ) ) );
+            K = _mm256_set1_epi32( static_cast<int>( 0x8F1BBCDC ) );
+        }
+        else
+        {
+            F = _mm256_xor_si256( B, _mm256_xor_si256( C, D ) );
+            K = _mm256_set1_epi32( static_cast<int>( 0xCA62C1D6 ) );
+        }
+
+        temp = _mm256_add_epi32( _mm256_add_epi32( sha1_rol_x8( A, 5 ), F ), _mm256_add_epi32( _mm256_add_epi32( E, K ), W[t & 15] ) );
+        E = D;
+        D = C;
+        C = sha1_rol_x8( B, 30 );
+        B = A;
+        A = temp;
+    }
+
+    state[0] = _mm256_add_epi32( state[0], A );
+    state[1] = _mm256_add_epi32( state[1], B );
+    state[2] = _mm256_add_epi32( state[2], C );
+    state[3] = _mm256_add_epi32( state[3], D );
+    state[4] = _mm256_add_epi32( state[4], E );
+}
+
+/*
+ * output[i] = SHA-1( input[i] ) for 8 messages of equal length
+ */
+AVX2_FUNC static void sha1_x8( const unsigned char *const input[8], size_t ilen, unsigned char output[8][20] )
+{
+    alignas(32) uint32_t digest[5][8];
+    unsigned char last[8][128] = {};
+    const unsigned char *data[8];
+    __m256i state[5];
+    size_t i, l;
+
+    state[0] = _mm256_set1_epi32( 0x67452301 );
+    state[1] = _mm256_set1_epi32( static_cast<int>( 0xEFCDAB89 ) );
+    state[2] = _mm256_set1_epi32( static_cast<int>( 0x98BADCFE ) );
+    state[3] = _mm256_set1_epi32( 0x10325476 );
+    state[4] = _mm256_set1_epi32( static_cast<int>( 0xC3D2E1F0 ) );
+
+    for( i = 0; i < ilen / 64; i++ )
+    {
+        for( l = 0; l < 8; l++ )
+            data[l] = input[l] + i * 64;
+
+        sha1_process_x8( state, data );
+    }
+
+    // Equal lengths: the padded tail has the same layout in every lane
+    const size_t tail = ilen % 64;
+    const size_t last_size = tail < 56 ? 64 : 128;
+    const uint32_t high = static_cast<uint32_t>( static_cast<uint64_t>( ilen ) >> 29 );
+    const uint32_t low = static_cast<uint32_t>( ilen << 3 );
+
+    for( l = 0; l < 8; l++ )
+    {
+        memcpy( last[l], input[l] + ilen - tail, tail );
+        last[l][tail] = 0x80;
+        PUT_UINT32_BE( high, last[l], last_size - 8 );
+        PUT_UINT32_BE( low,  last[l], last_size - 4 );
+    }
+
+    for( i = 0; i < last_size; i += 64 )
+    {
+        for( l = 0; l < 8; l++ )
+            data[l] = last[l] + i;
+
+        sha1_process_x8( state, data );
+    }
+
+    for( i = 0; i < 5; i++ )
+        _mm256_store_si256( reinterpret_cast<__m256i*>( digest[i] ), state[i] );
+
+    for( l = 0; l < 8; l++ )
+    {
+        for( i = 0; i < 5; i++ )
+            PUT_UINT32_BE( digest[i][l], output[l], i * 4 );
+    }
+}
+#endif
+
 void sha1_process( sha1_context *ctx, const unsigned char data[64] )
 {
     uint32_t temp, W[16], A, B, C, D, E;
 
+#if defined(ARCH_X64)
+    if( utils::has_sha_ni() )
+    {
+        sha1_process_shani( ctx->state, data, 1 );
+        return;
+    }
+#endif
+
     GET_UINT32_BE( W[ 0], data,  0 );
     GET_UINT32_BE( W[ 1], data,  4 );
     GET_UINT32_BE( W[ 2], data,  8 );
@@ -255,6 +474,15 @@ void sha1_update( sha1_context *ctx, const unsigned char *input, size_t ilen )
         left = 0;
     }
 
+#if defined(ARCH_X64)
+    if( ilen >= 64 && utils::has_sha_ni() )
+    {
+        sha1_process_shani( ctx->state, input, ilen / 64 );
+        input += ilen & ~static_cast<size_t>( 63 );
+        ilen  &= 63;
+    }
+#endif
+
     while( ilen >= 64 )
     {
         sha1_process( ctx, input );
@@ -317,6 +545,40 @@ void sha1( const unsigned char *input, size_t ilen, unsigned char output[20] )
     mbedtls_zeroize( &ctx, sizeof( sha1_context ) );
 }
 
+/*
+ * output[i] = SHA-1( input[i] ) for buffers of equal length
+ */
+void sha1_multi( const unsigned char *const *input, size_t ilen, unsigned char (*output)[20], size_t count )
+{
+#if defined(ARCH_X64)
+    // AVX2 lanes outperform SHA-NI on short messages (no per-message setup)
+    if( count > 1 && utils::has_avx2() )
+    {
+        const unsigned char *lanes[8];
+        unsigned char result[8][20];
+        size_t i, l;
+
+        for( i = 0; i < count; i += 8 )
+        {
+            const size_t n = count - i < 8 ? count - i : 8;
+
+            // Unused lanes repeat the first message
+            for( l = 0; l < 8; l++ )
+                lanes[l] = input[i + ( l < n ? l : 0 )];
+
+            sha1_x8( lanes, ilen, result );
+
+            memcpy( output + i, result, n * 20 );
+        }
+
+        return;
+    }
+#endif
+
+    for( size_t i = 0; i < count; i++ )
+        sha1( input[i], ilen, output[i] );
+}
+
 /*
  * SHA-1 HMAC context setup
  */
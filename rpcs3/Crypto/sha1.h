@@ -102,6 +102,17 @@ extern "C" {
  */
 void sha1( const unsigned char *input, size_t ilen, unsigned char output[20] );
 
+/**
+ * \brief          Output[i] = SHA-1( input[i] ) for count buffers of equal length
+ *                 (hashed in 8 parallel lanes with AVX2)
+ *
+ * \param input    pointers to the buffers holding the data
+ * \param ilen     length of each buffer
+ * \param output   SHA-1 checksum results
+ * \param count    number of buffers
+ */
+void sha1_multi( const unsigned char *const *input, size_t ilen, unsigned char (*output)[20], size_t count );
+
 /**
  * \brief          Output = SHA-1( file contents )
  *
@@ -7,13 +7,25 @@
 #include "utils.h"
 
 #include "Emu/system_utils.hpp"
+#include "Emu/IdManager.h"
+#include "Emu/io_thread_pool.h"
 
+#include "Utilities/Thread.h"
 #include "util/asm.hpp"
 #include <algorithm>
 #include <span>
 
 LOG_CHANNEL(edat_log, "EDAT");
 
+// Memory budget of the decrypted block cache of each EDATADecrypter
+constexpr u64 edat_cache_size = 1024 * 1024;
+
+// Blocks decrypted ahead of sequential reads
+constexpr u32 edat_read_ahead_blocks = 8;
+
+// Reads missing at least this many blocks are decrypted on the I/O thread pool
+constexpr u32 edat_parallel_min_blocks = 8;
+
 void generate_key(int crypto_mode, int version, unsigned char *key_final, unsigned char *iv_final, unsigned char *key, unsigned char *iv)
 {
 	int mode = crypto_mode & 0xF0000000;
@@ -861,6 +873,7 @@ bool EDATADecrypter::ReadHeader()
 
 	file_size = edatHeader.file_size;
 	total_blocks = ::narrow<u32>(utils::aligned_div(edatHeader.file_size, edatHeader.block_size));
+	m_cache_capacity = static_cast<u32>(std::clamp<u64>(edat_cache_size / std::max<s32>(edatHeader.block_size, 1), 4, 64));
 
 	// Try decrypting the first block instead
 	u8 data_sample[1];
@@ -874,6 +887,114 @@ bool EDATADecrypter::ReadHeader()
 	return true;
 }
 
+std::shared_ptr<const EDATADecrypter::decrypted_block> EDATADecrypter::DecryptBlock(u32 block) const
+{
+	auto result = std::make_shared<decrypted_block>();
+	result->index = block;
+	result->data.resize(edatHeader.block_size + 16);
+
+	// The headers and the key are only read, decryption can run on any thread
+	EDAT_HEADER edat = edatHeader;
+	NPD_HEADER npd = npdHeader;
+	u128 key = dec_key;
+
+	const u64 res = decrypt_block(&edata_file, result->data.data(), &edat, &npd, reinterpret_cast<uchar*>(&key), block, total_blocks, edat.file_size, true);
+
+	if (res == umax)
+	{
+		return nullptr;
+	}
+
+	result->size = res;
+	return result;
+}
+
+std::shared_ptr<const EDATADecrypter::decrypted_block> EDATADecrypter::FindCachedBlock(u32 block)
+{
+	std::lock_guard lock(m_cache_mutex);
+
+	for (auto it = m_cache.begin(); it != m_cache.end(); it++)
+	{
+		if ((*it)->index == block)
+		{
+			// Move to front
+			std::rotate(m_cache.begin(), it, it + 1);
+			return m_cache.front();
+		}
+	}
+
+	return nullptr;
+}
+
+void EDATADecrypter::CacheBlock(std::shared_ptr<const decrypted_block> block)
+{
+	std::lock_guard lock(m_cache_mutex);
+
+	if (!m_cache_capacity || std::any_of(m_cache.begin(), m_cache.end(), FN(x->index == block->index)))
+	{
+		return;
+	}
+
+	if (m_cache.size() >= m_cache_capacity)
+	{
+		m_cache.pop_back();
+	}
+
+	m_cache.insert(m_cache.begin(), std::move(block));
+}
+
+void EDATADecrypter::read_ahead_thread::operator()()
+{
+	for (u32 seq = dec->m_read_ahead_seq; thread_ctrl::state() != thread_state::aborting;)
+	{
+		thread_ctrl::wait_on(dec->m_read_ahead_seq, seq);
+		seq = dec->m_read_ahead_seq;
+
+		const u32 first = dec->m_read_ahead_block;
+		const u32 last = std::min<u32>(first + std::min<u32>(edat_read_ahead_blocks, dec->m_cache_capacity / 2), dec->total_blocks);
+
+		// Stop early when a newer request arrives
+		for (u32 i = first; i < last && seq == dec->m_read_ahead_seq && thread_ctrl::state() != thread_state::aborting; i++)
+		{
+			if (dec->FindCachedBlock(i))
+			{
+				continue;
+			}
+
+			if (auto block = dec->DecryptBlock(i))
+			{
+				dec->CacheBlock(std::move(block));
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+}
+
+void EDATADecrypter::RequestReadAhead(u32 first_block)
+{
+	if (first_block >= total_blocks || m_cache_capacity < 4)
+	{
+		return;
+	}
+
+	{
+		// The thread is only started for files that are actually streamed
+		std::lock_guard lock(m_cache_mutex);
+
+		if (!m_read_ahead)
+		{
+			m_read_ahead = std::make_shared<named_thread<read_ahead_thread>>(read_ahead_thread{this});
+		}
+	}
+
+	m_read_ahead_block = first_block;
+	m_read_ahead_seq++;
+	m_read_ahead_seq.notify_one();
+}
+
 u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 {
 	size = std::min<u64>(size, pos > edatHeader.file_size ? 0 : edatHeader.file_size - pos);
@@ -892,19 +1013,63 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 	const u32 starting_block = ::narrow<u32>(pos / edatHeader.block_size);
 	const u32 ending_block = ::narrow<u32>(std::min<u64>(starting_block + num_blocks, total_blocks));
 
-	u64 writeOffset = 0;
+	if (starting_block >= ending_block)
+	{
+		return 0;
+	}
 
-	std::vector<u8> data_buf(edatHeader.block_size + 16);
+	const u32 block_count = ending_block - starting_block;
 
-	for (u32 i = starting_block; i < ending_block; i++)
+	std::vector<std::shared_ptr<const decrypted_block>> blocks(block_count);
+	std::vector<u32> missing;
+
+	for (u32 i = 0; i < block_count; i++)
+	{
+		if (!(blocks[i] = FindCachedBlock(starting_block + i)))
+		{
+			missing.push_back(i);
+		}
+	}
+
+	atomic_t<bool> failed = false;
+
+	const auto decrypt_missing = [&](u32 index)
 	{
-		u64 res = decrypt_block(&edata_file, data_buf.data(), &edatHeader, &npdHeader, reinterpret_cast<uchar*>(&dec_key), i, total_blocks, edatHeader.file_size, true);
+		if (!failed && !(blocks[missing[index]] = DecryptBlock(starting_block + missing[index])))
+		{
+			failed = true;
+		}
+	};
+
+	// The pool only exists during emulation
+	const auto pool = missing.size() >= edat_parallel_min_blocks ? g_fxo->try_get<io_thread_pool>() : nullptr;
 
-		if (res == umax)
+	if (!pool || !pool->try_run(::size32(missing), decrypt_missing))
+	{
+		for (u32 i = 0; i < missing.size() && !failed; i++)
 		{
-			edat_log.error("Error Decrypting data");
-			return 0;
+			decrypt_missing(i);
 		}
+	}
+
+	if (failed)
+	{
+		edat_log.error("Error Decrypting data");
+		return 0;
+	}
+
+	// Keep small reads in the cache, large ones would only evict everything else
+	for (u32 i = block_count > m_cache_capacity / 2 ? block_count - 1 : 0; i < block_count; i++)
+	{
+		CacheBlock(blocks[i]);
+	}
+
+	u64 writeOffset = 0;
+
+	for (u32 i = starting_block; i < ending_block; i++)
+	{
+		const decrypted_block& block = *blocks[i - starting_block];
+		const u64 res = block.size;
 
 		const usz skip_start = (i == starting_block ? startOffset : 0);
 
@@ -916,11 +1081,16 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 		const usz end_pos = (i != total_blocks - 1 ? edatHeader.block_size : (edatHeader.file_size - 1) % edatHeader.block_size + 1);
 		const usz read_end = std::min<usz>(res, i == ending_block - 1 ? std::min<usz>(end_pos, (startOffset + size - 1) % edatHeader.block_size + 1) : end_pos);
 
-		std::memcpy(data + writeOffset, data_buf.data() + skip_start, read_end - skip_start);
-		std::memset(data_buf.data(), 0, read_end - skip_start);
+		std::memcpy(data + writeOffset, block.data.data() + skip_start, read_end - skip_start);
 
 		writeOffset += read_end - skip_start;
 	}
 
+	// Prefetch the following blocks when the file is read sequentially
+	if (const u32 prev_next_block = m_next_block.exchange(ending_block); prev_next_block == starting_block || prev_next_block == starting_block + 1)
+	{
+		RequestReadAhead(ending_block);
+	}
+
 	return writeOffset;
 }
@@ -1,7 +1,13 @@
 #pragma once
 
 #include <array>
+#include <memory>
+#include <vector>
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
+
+template <class Context>
+class named_thread;
 
 constexpr u32 SDAT_FLAG = 0x01000000;
 constexpr u32 EDAT_COMPRESSED_FLAG = 0x00000001;
@@ -82,6 +88,45 @@ struct EDATADecrypter final : fs::file_base
 
 	u128 dec_key{};
 
+	// Decrypted block, shared between the cache and the readers
+	struct decrypted_block
+	{
+		u32 index;
+		u64 size; // Valid bytes in data
+		std::vector<u8> data;
+	};
+
+	// LRU cache of decrypted blocks (most recently used first)
+	shared_mutex m_cache_mutex;
+	std::vector<std::shared_ptr<const decrypted_block>> m_cache;
+	u32 m_cache_capacity = 0;
+
+	// Sequential access detection for read-ahead
+	atomic_t<u32> m_next_block = umax;
+	atomic_t<u32> m_read_ahead_block = 0;
+	atomic_t<u32> m_read_ahead_seq = 0;
+
+	struct read_ahead_thread
+	{
+		static constexpr std::string_view thread_name = "EDAT Read-ahead";
+
+		EDATADecrypter* dec;
+
+		void operator()();
+	};
+
+	// Must be destroyed first
+	std::shared_ptr<named_thread<read_ahead_thread>> m_read_ahead;
+
+	// Decrypt one block, returns null on error
+	std::shared_ptr<const decrypted_block> DecryptBlock(u32 block) const;
+
+	std::shared_ptr<const decrypted_block> FindCachedBlock(u32 block);
+
+	void CacheBlock(std::shared_ptr<const decrypted_block> block);
+
+	void RequestReadAhead(u32 first_block);
+
 public:
 	EDATADecrypter(fs::file&& input, u128 dec_key = {}, std::string file_name = {}, bool is_key_final = true) noexcept
 		: m_edata_file(std::move(input))
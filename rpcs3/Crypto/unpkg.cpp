@@ -1410,29 +1410,39 @@ usz package_reader::decrypt(u64 offset, u64 size, const uchar* key, void* local_
 
 	if (m_header.pkg_type == PKG_RELEASE_TYPE_DEBUG)
 	{
-		// Debug key
-		be_t<u64> input[8] =
+		// Debug key: keystream blocks are hashed in batches
+		constexpr u64 batch_size = 64;
+
+		be_t<u64> input[batch_size][8]{};
+		const u8* input_ptrs[batch_size];
+		u8 hashes[batch_size][20];
+
+		for (u64 j = 0; j < batch_size; j++)
 		{
-			m_header.qa_digest[0],
-			m_header.qa_digest[0],
-			m_header.qa_digest[1],
-			m_header.qa_digest[1],
-		};
+			input[j][0] = m_header.qa_digest[0];
+			input[j][1] = m_header.qa_digest[0];
+			input[j][2] = m_header.qa_digest[1];
+			input[j][3] = m_header.qa_digest[1];
+			input_ptrs[j] = reinterpret_cast<const u8*>(input[j]);
+		}
 
-		for (u64 i = 0; i < blocks; i++)
+		for (u64 i = 0; i < blocks; i += batch_size)
 		{
-			// Initialize stream cipher for current position
-			input[7] = offset / 16 + i;
+			const u64 count = std::min<u64>(batch_size, blocks - i);
 
-			struct sha1_hash
+			// Initialize stream cipher for current positions
+			for (u64 j = 0; j < count; j++)
 			{
-				u8 data[20];
-			} hash{};
+				input[j][7] = offset / 16 + i + j;
+			}
 
-			sha1(reinterpret_cast<const u8*>(input), sizeof(input), hash.data);
+			sha1_multi(input_ptrs, sizeof(input[0]), hashes, count);
 
-			const u128 v = read_from_ptr<u128>(out_data, i * 16);
-			write_to_ptr<u128>(out_data, i * 16, v ^ read_from_ptr<u128>(hash.data));
+			for (u64 j = 0; j < count; j++)
+			{
+				const u128 v = read_from_ptr<u128>(out_data, (i + j) * 16);
+				write_to_ptr<u128>(out_data, (i + j) * 16, v ^ read_from_ptr<u128>(hashes[j]));
+			}
 		}
 	}
 	else if (m_header.pkg_type == PKG_RELEASE_TYPE_RELEASE)
@@ -1442,19 +1452,10 @@ usz package_reader::decrypt(u64 offset, u64 size, const uchar* key, void* local_
 		// Set encryption key for stream cipher
 		aes_setkey_enc(&ctx, key, 128);
 
-		// Initialize stream cipher for start position
+		// Initialize stream cipher for start position (big-endian counter)
 		be_t<u128> input = m_header.klicensee.value() + offset / 16;
 
-		// Increment stream position for every block
-		for (u64 i = 0; i < blocks; i++, input++)
-		{
-			u128 key;
-
-			aes_crypt_ecb(&ctx, AES_ENCRYPT, reinterpret_cast<const u8*>(&input), reinterpret_cast<u8*>(&key));
-
-			const u128 v = read_from_ptr<u128>(out_data, i * 16);
-			write_to_ptr<u128>(out_data, i * 16, v ^ key);
-		}
+		aes_crypt_ctr_blocks(&ctx, blocks, reinterpret_cast<u8*>(&input), out_data, out_data);
 	}
 	else
 	{
@@ -4,8 +4,45 @@
 #include "util/asm.hpp"
 #include "Emu/System.h"
 #include "Emu/system_utils.hpp"
+#include "Emu/IdManager.h"
+#include "Emu/io_thread_pool.h"
 #include "Crypto/unzip.h"
 
+// Run func(i) for count items, on the shared I/O thread pool when it is available
+// The pool is busy while decrypt_self_batch runs, the sections of each file stay on its worker then
+static void run_on_pool(u32 count, const io_thread_pool::chunk_func& func)
+{
+	// The pool only exists during emulation
+	const auto pool = g_fxo->try_get<io_thread_pool>();
+
+	if (!pool || !pool->try_run(count, func))
+	{
+		for (u32 i = 0; i < count; i++)
+		{
+			func(i);
+		}
+	}
+}
+
+// Run func(i) for every section, split across the pool when there is enough data
+static void for_each_section(u32 count, u64 data_size, const io_thread_pool::chunk_func& func)
+{
+	// Splitting costs more than decrypting small modules
+	constexpr u64 min_parallel_size = 256 * 1024;
+
+	if (data_size < min_parallel_size)
+	{
+		for (u32 i = 0; i < count; i++)
+		{
+			func(i);
+		}
+
+		return;
+	}
+
+	run_on_pool(count, func);
+}
+
 inline u8 Read8(const fs::file& f)
 {
 	u8 ret;
@@ -1161,8 +1198,6 @@ bool SELFDecrypter::LoadMetadata(const u8* klic_key)
 
 bool SELFDecrypter::DecryptData()
 {
-	aes_context aes;
-
 	// Calculate the total data size.
 	for (unsigned int i = 0; i < meta_hdr.section_count; i++)
 	{
@@ -1179,40 +1214,24 @@ bool SELFDecrypter::DecryptData()
 	// Set initial offset.
 	u32 data_buf_offset = 0;
 
+	// Offset of each encrypted section in data_buf.
+	std::vector<u32> section_offsets(meta_hdr.section_count, umax);
+
 	// Parse the metadata section headers to find the offsets of encrypted data.
+	// The source file is read on this thread only, it may not support concurrent access.
 	for (unsigned int i = 0; i < meta_hdr.section_count; i++)
 	{
-		usz ctr_nc_off = 0;
-		u8 ctr_stream_block[0x10];
-		u8 data_key[0x10];
-		u8 data_iv[0x10];
-
 		// Check if this is an encrypted section.
 		if (meta_shdr[i].encrypted == 3)
 		{
 			// Make sure the key and iv are not out of boundaries.
 			if((meta_shdr[i].key_idx <= meta_hdr.key_count - 1) && (meta_shdr[i].iv_idx <= meta_hdr.key_count))
 			{
-				// Get the key and iv from the previously stored key buffer.
-				memcpy(data_key, data_keys.get() + meta_shdr[i].key_idx * 0x10, 0x10);
-				memcpy(data_iv, data_keys.get() + meta_shdr[i].iv_idx * 0x10, 0x10);
-
-				// Allocate a buffer to hold the data.
-				auto buf = std::make_unique<u8[]>(meta_shdr[i].data_size);
+				section_offsets[i] = data_buf_offset;
 
 				// Seek to the section data offset and read the encrypted data.
 				self_f.seek(meta_shdr[i].data_offset);
-				self_f.read(buf.get(), meta_shdr[i].data_size);
-
-				// Zero out our ctr nonce.
-				memset(ctr_stream_block, 0, sizeof(ctr_stream_block));
-
-				// Perform AES-CTR encryption on the data blocks.
-				aes_setkey_enc(&aes, data_key, 128);
-				aes_crypt_ctr(&aes, meta_shdr[i].data_size, &ctr_nc_off, data_iv, ctr_stream_block, buf.get(), buf.get());
-
-				// Copy the decrypted data.
-				memcpy(data_buf.get() + data_buf_offset, buf.get(), meta_shdr[i].data_size);
+				self_f.read(data_buf.get() + data_buf_offset, meta_shdr[i].data_size);
 
 				// Advance the buffer's offset.
 				data_buf_offset += ::narrow<u32>(meta_shdr[i].data_size);
@@ -1220,9 +1239,87 @@ bool SELFDecrypter::DecryptData()
 		}
 	}
 
+	// Decrypt the sections, each one has its own key and iv.
+	for_each_section(meta_hdr.section_count, data_buf_length, [&](u32 i)
+	{
+		if (section_offsets[i] == umax)
+		{
+			return;
+		}
+
+		aes_context aes;
+		usz ctr_nc_off = 0;
+		u8 ctr_stream_block[0x10]{};
+		u8 data_key[0x10];
+		u8 data_iv[0x10];
+
+		// Get the key and iv from the previously stored key buffer.
+		memcpy(data_key, data_keys.get() + meta_shdr[i].key_idx * 0x10, 0x10);
+		memcpy(data_iv, data_keys.get() + meta_shdr[i].iv_idx * 0x10, 0x10);
+
+		u8* const data = data_buf.get() + section_offsets[i];
+
+		// Perform AES-CTR encryption on the data blocks.
+		aes_setkey_enc(&aes, data_key, 128);
+		aes_crypt_ctr(&aes, meta_shdr[i].data_size, &ctr_nc_off, data_iv, ctr_stream_block, data, data);
+	});
+
 	return true;
 }
 
+std::vector<std::unique_ptr<u8[]>> SELFDecrypter::DecompressSections(const std::vector<u64>& decomp_sizes) const
+{
+	std::vector<std::unique_ptr<u8[]>> result(meta_hdr.section_count);
+	std::vector<u32> section_offsets(meta_hdr.section_count);
+
+	u32 data_buf_offset = 0;
+	u64 total_size = 0;
+
+	// Locate the compressed data the same way WriteElf does.
+	for (unsigned int i = 0; i < meta_hdr.section_count; i++)
+	{
+		if (meta_shdr[i].type != 2)
+		{
+			continue;
+		}
+
+		section_offsets[i] = data_buf_offset;
+
+		if (decomp_sizes[i])
+		{
+			result[i] = std::make_unique<u8[]>(decomp_sizes[i]);
+			total_size += decomp_sizes[i];
+		}
+
+		data_buf_offset += ::narrow<u32>(meta_shdr[i].data_size);
+	}
+
+	for_each_section(meta_hdr.section_count, total_size, [&](u32 i)
+	{
+		if (!result[i])
+		{
+			return;
+		}
+
+		uLongf decomp_buf_length = ::narrow<uLongf>(decomp_sizes[i]);
+
+		// The stream ends by itself, the rest of data_buf is the upper bound of its size.
+		const u32 offset = std::min(section_offsets[i], data_buf_length);
+		const int rv = uncompress(result[i].get(), &decomp_buf_length, data_buf.get() + offset, data_buf_length - offset);
+
+		// Check for errors (TODO: Probably safe to remove this once these changes have passed testing.)
+		switch (rv)
+		{
+		case Z_MEM_ERROR: self_log.error("MakeELF encountered a Z_MEM_ERROR!"); break;
+		case Z_BUF_ERROR: self_log.error("MakeELF encountered a Z_BUF_ERROR!"); break;
+		case Z_DATA_ERROR: self_log.error("MakeELF encountered a Z_DATA_ERROR!"); break;
+		default: break;
+		}
+	});
+
+	return result;
+}
+
 fs::file SELFDecrypter::MakeElf(bool isElf32)
 {
 	// Create a new ELF file.
@@ -1435,6 +1532,19 @@ fs::file decrypt_self(const fs::file& elf_or_self, const u8* klic_key, SelfAddit
 	return {};
 }
 
+std::vector<fs::file> decrypt_self_batch(const std::vector<fs::file>& files, const u8* klic_key)
+{
+	std::vector<fs::file> result(files.size());
+
+	// One file per thread at a time
+	run_on_pool(::size32(files), [&](u32 i)
+	{
+		result[i] = decrypt_self(files[i], klic_key);
+	});
+
+	return result;
+}
+
 bool verify_npdrm_self_headers(const fs::file& self, u8* klic_key, NPD_HEADER* npd_out)
 {
 	if (!self)
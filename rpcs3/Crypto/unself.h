@@ -483,6 +483,9 @@ public:
 	static bool GetKeyFromRap(const char *content_id, u8 *npdrm_key);
 
 private:
+	// Inflate the sections with a non-zero decompressed size (in parallel if large enough).
+	std::vector<std::unique_ptr<u8[]>> DecompressSections(const std::vector<u64>& decomp_sizes) const;
+
 	template<typename EHdr, typename SHdr, typename PHdr>
 	void WriteElf(fs::file& e, EHdr ehdr, SHdr shdr, PHdr phdr)
 	{
@@ -498,46 +501,33 @@ private:
 			WritePhdr(e, phdr[i]);
 		}
 
+		// Inflate all compressed segments first.
+		std::vector<u64> decomp_sizes(meta_hdr.section_count);
+
+		for (unsigned int i = 0; i < meta_hdr.section_count; i++)
+		{
+			if (meta_shdr[i].type == 2 && meta_shdr[i].compressed == 2)
+			{
+				decomp_sizes[i] = phdr[meta_shdr[i].program_idx].p_filesz;
+			}
+		}
+
+		const std::vector<std::unique_ptr<u8[]>> decomp_bufs = DecompressSections(decomp_sizes);
+
 		for (unsigned int i = 0; i < meta_hdr.section_count; i++)
 		{
 			// PHDR type.
 			if (meta_shdr[i].type == 2)
 			{
-				// Decompress if necessary.
+				// Seek to the program header data offset and write the data.
+				e.seek(phdr[meta_shdr[i].program_idx].p_offset);
+
 				if (meta_shdr[i].compressed == 2)
 				{
-					const auto filesz = phdr[meta_shdr[i].program_idx].p_filesz;
-
-					// Create a pointer to a buffer for decompression.
-					std::unique_ptr<u8[]> decomp_buf(new u8[filesz]);
-
-					// Create a buffer separate from data_buf to uncompress.
-					std::unique_ptr<u8[]> zlib_buf(new u8[data_buf_length]);
-					memcpy(zlib_buf.get(), data_buf.get(), data_buf_length);
-
-					uLongf decomp_buf_length = ::narrow<uLongf>(filesz);
-
-					// Use zlib uncompress on the new buffer.
-					// decomp_buf_length changes inside the call to uncompress
-					const int rv = uncompress(decomp_buf.get(), &decomp_buf_length, zlib_buf.get() + data_buf_offset, data_buf_length);
-
-					// Check for errors (TODO: Probably safe to remove this once these changes have passed testing.)
-					switch (rv)
-					{
-					case Z_MEM_ERROR: self_log.error("MakeELF encountered a Z_MEM_ERROR!"); break;
-					case Z_BUF_ERROR: self_log.error("MakeELF encountered a Z_BUF_ERROR!"); break;
-					case Z_DATA_ERROR: self_log.error("MakeELF encountered a Z_DATA_ERROR!"); break;
-					default: break;
-					}
-
-					// Seek to the program header data offset and write the data.
-					e.seek(phdr[meta_shdr[i].program_idx].p_offset);
-					e.write(decomp_buf.get(), filesz);
+					e.write(decomp_bufs[i].get(), decomp_sizes[i]);
 				}
 				else
 				{
-					// Seek to the program header data offset and write the data.
-					e.seek(phdr[meta_shdr[i].program_idx].p_offset);
 					e.write(data_buf.get() + data_buf_offset, meta_shdr[i].data_size);
 				}
 
@@ -560,6 +550,9 @@ private:
 };
 
 fs::file decrypt_self(const fs::file& elf_or_self, const u8* klic_key = nullptr, SelfAdditionalInfo* additional_info = nullptr);
+
+// Decrypt a set of SELF files concurrently on the I/O thread pool, results are returned in input order (empty on failure)
+std::vector<fs::file> decrypt_self_batch(const std::vector<fs::file>& files, const u8* klic_key = nullptr);
 bool verify_npdrm_self_headers(const fs::file& self, u8* klic_key = nullptr, NPD_HEADER* npd_out = nullptr);
 bool get_npdrm_self_header(const fs::file& self, NPD_HEADER& npd);
 
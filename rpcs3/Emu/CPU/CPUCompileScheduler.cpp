@@ -0,0 +1,126 @@
+#include "stdafx.h"
+#include "CPUCompileScheduler.h"
+
+#include "Emu/IdManager.h"
+#include "Emu/system_config.h"
+#include "util/sysinfo.hpp"
+
+#include <numeric>
+
+template <>
+void fmt_class_string<jit_compile_stats>::format(std::string& out, u64 arg)
+{
+	const auto& stats = get_object(arg);
+
+	fmt::append(out, "limit=%u, blocking=%u/%u/%u, likely=%u/%u/%u, speculative=%u/%u/%u (active/waiting/done)", stats.limit
+		, stats.active[0], stats.waiting[0], stats.done[0]
+		, stats.active[1], stats.waiting[1], stats.done[1]
+		, stats.active[2], stats.waiting[2], stats.done[2]);
+}
+
+jit_compile_scheduler::jit_compile_scheduler() noexcept
+	: m_limit(std::max<u32>(g_cfg.core.llvm_threads ? std::min<u32>(g_cfg.core.llvm_threads, utils::get_thread_count()) : utils::get_thread_count(), 1))
+{
+}
+
+bool jit_compile_scheduler::can_run(jit_priority priority) const
+{
+	const u32 index = static_cast<u32>(priority);
+
+	if (priority == jit_priority::blocking)
+	{
+		return true;
+	}
+
+	for (u32 i = 0; i < index; i++)
+	{
+		if (m_waiting[i])
+		{
+			return false;
+		}
+	}
+
+	return std::accumulate(m_active.begin(), m_active.end(), u32{0}) < m_limit;
+}
+
+void jit_compile_scheduler::acquire(jit_priority priority)
+{
+	const u32 index = static_cast<u32>(priority);
+
+	std::unique_lock lock(m_mutex);
+
+	m_waiting[index]++;
+
+	while (!can_run(priority))
+	{
+		const u32 old = m_signal;
+		lock.unlock();
+		m_signal.wait(old);
+		lock.lock();
+	}
+
+	m_waiting[index]--;
+	m_active[index]++;
+}
+
+void jit_compile_scheduler::release(jit_priority priority)
+{
+	const u32 index = static_cast<u32>(priority);
+
+	{
+		std::lock_guard lock(m_mutex);
+
+		ensure(m_active[index]--);
+		m_done[index]++;
+		m_signal++;
+	}
+
+	m_signal.notify_all();
+}
+
+bool jit_compile_scheduler::should_yield(jit_priority priority)
+{
+	if (priority == jit_priority::blocking)
+	{
+		return false;
+	}
+
+	reader_lock lock(m_mutex);
+
+	for (u32 i = 0; i < static_cast<u32>(priority); i++)
+	{
+		if (m_waiting[i])
+		{
+			return true;
+		}
+	}
+
+	return std::accumulate(m_active.begin(), m_active.end(), u32{0}) > m_limit;
+}
+
+jit_compile_stats jit_compile_scheduler::get_stats()
+{
+	reader_lock lock(m_mutex);
+	return {m_limit, m_active, m_waiting, m_done};
+}
+
+void jit_compile_slot::lock()
+{
+	g_fxo->get<jit_compile_scheduler>().acquire(m_priority);
+}
+
+void jit_compile_slot::unlock()
+{
+	g_fxo->get<jit_compile_scheduler>().release(m_priority);
+}
+
+void jit_compile_slot::yield()
+{
+	auto& scheduler = g_fxo->get<jit_compile_scheduler>();
+
+	if (scheduler.should_yield(m_priority))
+	{
+		scheduler.release(m_priority);
+		scheduler.acquire(m_priority);
+	}
+}
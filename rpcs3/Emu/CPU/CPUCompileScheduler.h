@@ -0,0 +1,76 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/atomic.hpp"
+#include "Utilities/mutex.h"
+
+#include <array>
+
+// Priority classes of JIT compilation work (highest first)
+enum class jit_priority : u32
+{
+	blocking, // A running thread waits for the result
+	likely, // Needed soon (modules of the booting title, SPU cache)
+	speculative, // Precompilation which may never be used
+
+	count
+};
+
+struct jit_compile_stats
+{
+	u32 limit;
+	std::array<u32, 3> active;
+	std::array<u32, 3> waiting;
+	std::array<u64, 3> done;
+};
+
+// Compilation slots shared by PPU and SPU workers, limited by "Max LLVM Compile Threads"
+// Blocking work is never delayed (it may exceed the limit), other classes wait for a free slot in priority order
+class jit_compile_scheduler
+{
+	shared_mutex m_mutex;
+	atomic_t<u32> m_signal = 0;
+
+	const u32 m_limit;
+
+	std::array<u32, 3> m_active{};
+	std::array<u32, 3> m_waiting{};
+	std::array<u64, 3> m_done{};
+
+	bool can_run(jit_priority priority) const;
+
+public:
+	jit_compile_scheduler() noexcept;
+
+	jit_compile_scheduler(const jit_compile_scheduler&) = delete;
+	jit_compile_scheduler& operator=(const jit_compile_scheduler&) = delete;
+
+	// Wait for a slot
+	void acquire(jit_priority priority);
+
+	void release(jit_priority priority);
+
+	// Whether a slot of this priority should be given up (higher priority work waits or blocking work exceeds the limit)
+	bool should_yield(jit_priority priority);
+
+	jit_compile_stats get_stats();
+};
+
+// Compilation slot of a fixed priority, usable with std::lock_guard and std::unique_lock
+class jit_compile_slot
+{
+	const jit_priority m_priority;
+
+public:
+	explicit jit_compile_slot(jit_priority priority) noexcept
+		: m_priority(priority)
+	{
+	}
+
+	void lock();
+
+	void unlock();
+
+	// Call between jobs while holding the slot: lets higher priority work run first
+	void yield();
+};
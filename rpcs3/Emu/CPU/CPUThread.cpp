@@ -9,6 +9,7 @@
 #include "Emu/IdManager.h"
 #include "Emu/GDB.h"
 #include "Emu/Cell/lv2/sys_spu.h"
+#include "Emu/Cell/lv2/sys_prx.h"
 #include "Emu/Cell/PPUThread.h"
 #include "Emu/Cell/SPUThread.h"
 #include "Emu/RSX/RSXThread.h"
@@ -24,6 +25,8 @@
 #include <emmintrin.h>
 #endif
 
+extern const std::unordered_map<u32, std::string_view>& get_exported_function_names_as_addr_indexed_map();
+
 DECLARE(cpu_thread::g_threads_created){0};
 DECLARE(cpu_thread::g_threads_deleted){0};
 DECLARE(cpu_thread::g_suspend_counter){0};
@@ -178,12 +181,25 @@ struct cpu_prof
 		// Avoid printing replicas or when not much changed
 		u64 new_samples = 0;
 
+		struct call_chain
+		{
+			// Return addresses, innermost frame first
+			std::vector<u32> frames;
+			u64 count = 0;
+		};
+
+		// PPU call chains: chain hash -> frames and sample count
+		std::unordered_map<u64, call_chain, value_hash<u64>> chains;
+
 		static constexpr u64 min_print_samples = 500;
 		static constexpr u64 min_print_all_samples = min_print_samples * 20;
 
+		static constexpr usz max_call_depth = 16;
+
 		void reset()
 		{
 			freq.clear();
+			chains.clear();
 			samples = 0;
 			idle = 0;
 			new_samples = 0;
@@ -242,6 +258,54 @@ struct cpu_prof
 			return 100. * dividend / divisor;
 		}
 
+		// Walk the PPU stack back chain (saved LR is at offset 16 of the caller's frame), may be inaccurate
+		void record_call_chain(const ppu_thread& ppu, u32 cia)
+		{
+			std::array<u32, max_call_depth> frames;
+			usz depth = 0;
+			frames[depth++] = cia;
+
+			u64 hash = cia;
+			u32 sp = static_cast<u32>(atomic_storage<u64>::load(ppu.gpr[1]));
+
+			while (depth < max_call_depth)
+			{
+				// The thread keeps running, pages may be unmapped between checking and reading
+				be_t<u64> data;
+
+				if (sp % 16 || !vm::try_access(sp, &data, sizeof(data), false))
+				{
+					break;
+				}
+
+				const u32 back_chain = static_cast<u32>(data);
+
+				// The stack grows down
+				if (back_chain <= sp || back_chain % 16 || !vm::try_access(back_chain + 16, &data, sizeof(data), false))
+				{
+					break;
+				}
+
+				const u32 ret = static_cast<u32>(data);
+
+				if (ret % 4 || !vm::check_addr(ret, vm::page_executable))
+				{
+					break;
+				}
+
+				frames[depth++] = ret;
+				hash = std::rotl(hash, 17) * 0x9e3779b97f4a7c15 + ret;
+				sp = back_chain;
+			}
+
+			auto& chain = chains[hash ^ depth];
+
+			if (!chain.count++)
+			{
+				chain.frames.assign(frames.begin(), frames.begin() + depth);
+			}
+		}
+
 		// Print info
 		void print(const shared_ptr<cpu_thread>& ptr)
 		{
@@ -330,6 +394,155 @@ struct cpu_prof
 			const std::string results = format(chart, samples, idle, type_id, true);
 			profiler.notice("All %s Threads: %u samples (%.4f%% idle), %u new, %u reservation (%.4f%%):%s", type_id == 1 ? "PPU" : "SPU", samples, get_percent(idle, samples), new_samples, reservation, get_percent(reservation, samples - idle), results);
 		}
+
+		// Write samples as collapsed stacks (one "thread;outer;...;inner count" line per stack), readable by flamegraph.pl, inferno or speedscope
+		static void export_all(const std::unordered_map<shared_ptr<cpu_thread>, sample_info>& threads, u32 type_id)
+		{
+			std::vector<std::pair<const shared_ptr<cpu_thread>*, const sample_info*>> list;
+
+			for (auto& [ptr, info] : threads)
+			{
+				if (ptr->id_type() == type_id && info.samples)
+				{
+					list.emplace_back(&ptr, &info);
+				}
+			}
+
+			if (list.empty())
+			{
+				return;
+			}
+
+			std::sort(list.begin(), list.end(), [](auto& a, auto& b) { return (*a.first)->id < (*b.first)->id; });
+
+			// PPU functions: start -> (size or 0 if unknown, name)
+			std::map<u32, std::pair<u32, std::string>> funcs;
+
+			const auto add_funcs = [&](const std::vector<ppu_function>& module_funcs)
+			{
+				for (const ppu_function& func : module_funcs)
+				{
+					auto& [size, name] = funcs[func.addr];
+					size = func.size;
+
+					if (name.empty())
+					{
+						name = fmt::format("sub_%x", func.addr);
+					}
+				}
+			};
+
+			if (type_id == 1)
+			{
+				for (const auto& [addr, name] : get_exported_function_names_as_addr_indexed_map())
+				{
+					funcs[addr].second = name;
+				}
+
+				if (auto _main = g_fxo->try_get<main_ppu_module<lv2_obj>>())
+				{
+					add_funcs(_main->funcs);
+				}
+
+				idm::select<lv2_obj, lv2_prx>([&](u32, lv2_prx& prx)
+				{
+					add_funcs(prx.funcs);
+				});
+			}
+
+			const auto get_ppu_symbol = [&](u32 addr) -> std::string
+			{
+				if (auto found = funcs.upper_bound(addr); found != funcs.begin())
+				{
+					const auto& [start, func] = *--found;
+
+					if (!func.first || addr - start < func.first)
+					{
+						return func.second;
+					}
+				}
+
+				return fmt::format("0x%07x", addr);
+			};
+
+			const auto get_spu_symbol = [](u64 name)
+			{
+				// Same naming as the text output: 7 hash characters and the chunk address
+				std::string result = fmt::format("%s", fmt::base57(be_t<u64>{name}));
+				result.resize(result.size() - 4);
+				fmt::append(result, "...chunk-0x%05x", (name & 0xffff) * 4);
+				return result;
+			};
+
+			std::string out;
+
+			for (auto [ptr, info] : list)
+			{
+				std::string root = fmt::format("%s [0x%08x]", (*ptr)->get_name(), (*ptr)->id);
+				std::replace(root.begin(), root.end(), ';', ':');
+
+				if (info->idle)
+				{
+					fmt::append(out, "%s;[idle] %u\n", root, info->idle);
+				}
+
+				if (type_id == 1)
+				{
+					for (auto& [hash, chain] : info->chains)
+					{
+						out += root;
+
+						// Outermost frame first, merging recursion within the same function
+						std::string last;
+
+						for (auto it = chain.frames.rbegin(); it != chain.frames.rend(); it++)
+						{
+							std::string symbol = get_ppu_symbol(*it);
+
+							if (symbol != last)
+							{
+								out += ';';
+								out += symbol;
+								last = std::move(symbol);
+							}
+						}
+
+						fmt::append(out, " %u\n", chain.count);
+					}
+				}
+				else
+				{
+					for (auto& [name, count] : info->freq)
+					{
+						fmt::append(out, "%s;%s %u\n", root, get_spu_symbol(name), count);
+					}
+				}
+			}
+
+			const std::string path = fmt::format("%sprofile_%s_%s.folded", fs::get_log_dir(), type_id == 1 ? "ppu" : "spu", Emu.GetTitleID().empty() ? "unknown"sv : std::string_view{Emu.GetTitleID()});
+
+			if (fs::write_file(path, fs::rewrite, out))
+			{
+				profiler.success("%s samples exported to \"%s\"", type_id == 1 ? "PPU" : "SPU", path);
+			}
+			else
+			{
+				profiler.error("Failed to export %s samples to \"%s\" (%s)", type_id == 1 ? "PPU" : "SPU", path, fs::g_tls_error);
+			}
+		}
+
+		static void export_enabled(const std::unordered_map<shared_ptr<cpu_thread>, sample_info>& threads)
+		{
+			if (g_cfg.core.ppu_prof)
+			{
+				export_all(threads, 1);
+			}
+
+			if (g_cfg.core.spu_prof)
+			{
+				export_all(threads, 2);
+			}
+		}
 	};
 
 	sample_info all_spu_threads_info{};
@@ -408,6 +621,11 @@ struct cpu_prof
 						info.freq[name]++;
 						info.new_samples++;
 
+						if (ppu && g_cfg.core.ppu_prof)
+						{
+							info.record_call_chain(*ppu, static_cast<u32>(name));
+						}
+
 						if (spu)
 						{
 							if (spu->raddr)
@@ -445,6 +663,7 @@ struct cpu_prof
 				all_spu_threads_info = {};
 				sample_info::print_all(threads, all_ppu_threads_info, 1);
 				sample_info::print_all(threads, all_spu_threads_info, 2);
+				sample_info::export_enabled(threads);
 			}
 
 			if (Emu.IsPaused())
@@ -467,6 +686,7 @@ struct cpu_prof
 		// Print all remaining results
 		sample_info::print_all(threads, all_ppu_threads_info, 1);
 		sample_info::print_all(threads, all_spu_threads_info, 2);
+		sample_info::export_enabled(threads);
 	}
 
 	static constexpr auto thread_name = "CPU Profiler"sv;
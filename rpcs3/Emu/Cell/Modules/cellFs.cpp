@@ -8,6 +8,7 @@
 #include "cellFs.h"
 
 #include <mutex>
+#include <shared_mutex>
 
 LOG_CHANNEL(cellFs);
 
@@ -913,15 +914,19 @@ struct fs_aio_thread : ppu_thread
 			if (!file || (type == 1 && file->flags & CELL_FS_O_WRONLY) || (type == 2 && !(file->flags & CELL_FS_O_ACCMODE)))
 			{
 			}
+			else if (type == 1)
+			{
+				// Positional read, the file position is left untouched
+				if (std::shared_lock lock(file->mp->mutex); file->file)
+				{
+					result = file->op_read(aio->buf, aio->size, aio->offset);
+					error = CELL_OK;
+				}
+			}
 			else if (std::lock_guard lock(file->mp->mutex); file->file)
 			{
-				const auto old_pos = file->file.pos(); file->file.seek(aio->offset);
-
-				result = type == 2
-					? file->op_write(aio->buf, aio->size)
-					: file->op_read(aio->buf, aio->size);
-
-				file->file.seek(old_pos);
+				// Positional write, the file position is left untouched
+				result = file->op_write(aio->buf, aio->size, aio->offset);
 				error = CELL_OK;
 			}
 
@@ -6,8 +6,11 @@
 #include "Emu/Cell/lv2/sys_ppu_thread.h"
 #include "Emu/Cell/lv2/sys_process.h"
 #include "Emu/savestate_utils.hpp"
+#include "Emu/system_config.h"
 #include "sysPrxForUser.h"
 #include "util/media_utils.h"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -263,6 +266,11 @@ struct vdec_context final
 			fmt::throw_exception("avcodec_alloc_context3() failed (type=0x%x)", type);
 		}
 
+		// Slice threading only: frame threading delays each picture by one frame per thread,
+		// while games expect the picture of an AU to be output along with its AUDONE
+		ctx->thread_count = g_cfg.core.vdec_threads;
+		ctx->thread_type = FF_THREAD_SLICE;
+
 		AVDictionary* opts = nullptr;
 
 		std::lock_guard lock(g_mutex_avcodec_open2);
@@ -1271,6 +1279,110 @@ error_code cellVdecDecodeAuEx2(ppu_thread& ppu, u32 handle, CellVdecDecodeMode m
 	return CELL_OK;
 }
 
+// YUV to RGB coefficients (fixed point with 6 fractional bits)
+struct vdec_yuv_matrix
+{
+	s16 y_offset;
+	s16 y_scale;
+	s16 rv, gu, gv, bu;
+};
+
+static constexpr vdec_yuv_matrix s_vdec_bt601 = { 16, 75, 102, 25, 52, 129 };
+static constexpr vdec_yuv_matrix s_vdec_bt709 = { 16, 75, 115, 14, 34, 135 };
+static constexpr vdec_yuv_matrix s_vdec_bt601_full = { 0, 64, 90, 22, 46, 113 };
+
+// Convert YUV420P frame to ARGB32 or RGBA32 with constant alpha
+static void vdec_yuv420p_to_rgb32(const AVFrame* frame, u8* out, bool argb, u8 alpha, const vdec_yuv_matrix& m)
+{
+	const int w = frame->width;
+	const int h = frame->height;
+
+	const v128 zero = gv_bcst8(0);
+	const v128 a = gv_bcst8(alpha);
+	const v128 c128 = gv_bcst16(128);
+	const v128 round = gv_bcst16(32);
+	const v128 y_offset = gv_bcst16(m.y_offset);
+	const v128 y_scale = gv_bcst16(m.y_scale);
+	const v128 k_rv = gv_bcst16(m.rv);
+	const v128 k_gu = gv_bcst16(m.gu);
+	const v128 k_gv = gv_bcst16(m.gv);
+	const v128 k_bu = gv_bcst16(m.bu);
+
+	for (int y = 0; y < h; y++)
+	{
+		const u8* y_row = frame->data[0] + y * frame->linesize[0];
+		const u8* u_row = frame->data[1] + (y / 2) * frame->linesize[1];
+		const u8* v_row = frame->data[2] + (y / 2) * frame->linesize[2];
+		u8* dst = out + y * w * 4;
+
+		int x = 0;
+
+		// 16 pixels per iteration
+		for (; x + 16 <= w; x += 16, dst += 64)
+		{
+			u64 u_raw, v_raw;
+			std::memcpy(&u_raw, u_row + x / 2, 8);
+			std::memcpy(&v_raw, v_row + x / 2, 8);
+
+			const v128 y_samples = v128::loadu(y_row + x);
+			const v128 u_samples = v128::from64(u_raw);
+			const v128 v_samples = v128::from64(v_raw);
+
+			// Horizontal chroma upsampling (duplicate samples)
+			const v128 u_dup = gv_unpacklo8(u_samples, u_samples);
+			const v128 v_dup = gv_unpacklo8(v_samples, v_samples);
+
+			v128 rgb[3][2];
+
+			for (int i = 0; i < 2; i++)
+			{
+				const v128 luma = gv_mul16(gv_sub16(i ? gv_unpackhi8(y_samples, zero) : gv_unpacklo8(y_samples, zero), y_offset), y_scale);
+				const v128 cb = gv_sub16(i ? gv_unpackhi8(u_dup, zero) : gv_unpacklo8(u_dup, zero), c128);
+				const v128 cr = gv_sub16(i ? gv_unpackhi8(v_dup, zero) : gv_unpacklo8(v_dup, zero), c128);
+
+				rgb[0][i] = gv_sar16(gv_adds_s16(gv_adds_s16(luma, gv_mul16(cr, k_rv)), round), 6);
+				rgb[1][i] = gv_sar16(gv_adds_s16(gv_subs_s16(gv_subs_s16(luma, gv_mul16(cb, k_gu)), gv_mul16(cr, k_gv)), round), 6);
+				rgb[2][i] = gv_sar16(gv_adds_s16(gv_adds_s16(luma, gv_mul16(cb, k_bu)), round), 6);
+			}
+
+			const v128 r = gv_packus_s16(rgb[0][0], rgb[0][1]);
+			const v128 g = gv_packus_s16(rgb[1][0], rgb[1][1]);
+			const v128 b = gv_packus_s16(rgb[2][0], rgb[2][1]);
+
+			// Interleave components into 32-bit pixels (byte order in memory)
+			const v128 lo0 = argb ? gv_unpacklo8(a, r) : gv_unpacklo8(r, g);
+			const v128 hi0 = argb ? gv_unpackhi8(a, r) : gv_unpackhi8(r, g);
+			const v128 lo1 = argb ? gv_unpacklo8(g, b) : gv_unpacklo8(b, a);
+			const v128 hi1 = argb ? gv_unpackhi8(g, b) : gv_unpackhi8(b, a);
+
+			v128::storeu(gv_unpacklo16(lo0, lo1), dst, 0);
+			v128::storeu(gv_unpackhi16(lo0, lo1), dst, 1);
+			v128::storeu(gv_unpacklo16(hi0, hi1), dst, 2);
+			v128::storeu(gv_unpackhi16(hi0, hi1), dst, 3);
+		}
+
+		for (; x < w; x++, dst += 4)
+		{
+			const s32 luma = (y_row[x] - m.y_offset) * m.y_scale;
+			const s32 cb = u_row[x / 2] - 128;
+			const s32 cr = v_row[x / 2] - 128;
+
+			const u8 r = static_cast<u8>(std::clamp((luma + m.rv * cr + 32) >> 6, 0, 255));
+			const u8 g = static_cast<u8>(std::clamp((luma - m.gu * cb - m.gv * cr + 32) >> 6, 0, 255));
+			const u8 b = static_cast<u8>(std::clamp((luma + m.bu * cb + 32) >> 6, 0, 255));
+
+			if (argb)
+			{
+				dst[0] = alpha, dst[1] = r, dst[2] = g, dst[3] = b;
+			}
+			else
+			{
+				dst[0] = r, dst[1] = g, dst[2] = b, dst[3] = alpha;
+			}
+		}
+	}
+}
+
 error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecPicFormat2> format, vm::ptr<u8> outBuff, u32 arg4)
 {
 	ppu.state += cpu_flag::wait;
@@ -1346,12 +1458,10 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 
 		AVPixelFormat out_f = AV_PIX_FMT_YUV420P;
 
-		std::unique_ptr<u8[]> alpha_plane;
-
 		switch (const u32 type = format->formatType)
 		{
-		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; alpha_plane.reset(new u8[w * h]); break;
-		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; alpha_plane.reset(new u8[w * h]); break;
+		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; break;
+		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; break;
 		case CELL_VDEC_PICFMT_UYVY422_ILV: out_f = AV_PIX_FMT_UYVY422; break;
 		case CELL_VDEC_PICFMT_YUV420_PLANAR: out_f = AV_PIX_FMT_YUV420P; break;
 		default:
@@ -1360,13 +1470,6 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 		}
 		}
 
-		// TODO: color matrix
-
-		if (alpha_plane)
-		{
-			std::memset(alpha_plane.get(), format->alpha, w * h);
-		}
-
 		AVPixelFormat in_f = AV_PIX_FMT_YUV420P;
 
 		switch (frame->format)
@@ -1375,38 +1478,49 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 			cellVdec.error("cellVdecGetPictureExt: experimental AVPixelFormat (handle=0x%x, seq_id=%d, cmd_id=%d, format=%d). This may cause suboptimal video quality.", handle, frame.seq_id, frame.cmd_id, frame->format);
 			[[fallthrough]];
 		case AV_PIX_FMT_YUV420P:
-			in_f = alpha_plane ? AV_PIX_FMT_YUVA420P : static_cast<AVPixelFormat>(frame->format);
+			in_f = static_cast<AVPixelFormat>(frame->format);
 			break;
 		default:
 			fmt::throw_exception("cellVdecGetPictureExt: Unknown frame format (%d)", frame->format);
 		}
 
-		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, in_f=%d, out_f=%d, alpha_plane=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +in_f, +out_f, !!alpha_plane, format->alpha, format->colorMatrixType);
-
-		vdec->sws = sws_getCachedContext(vdec->sws, w, h, in_f, w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
-
-		u8* in_data[4] = { frame->data[0], frame->data[1], frame->data[2], alpha_plane.get() };
-		int in_line[4] = { frame->linesize[0], frame->linesize[1], frame->linesize[2], w * 1 };
-		u8* out_data[4] = { outBuff.get_ptr() };
-		int out_line[4] = { w * 4 }; // RGBA32 or ARGB32
+		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, in_f=%d, out_f=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +in_f, +out_f, format->alpha, format->colorMatrixType);
 
 		// TODO:
 		// It's possible that we need to align the pitch to 128 here.
 		// PS HOME seems to rely on this somehow in certain cases.
 
-		if (!alpha_plane)
+		if (out_f == AV_PIX_FMT_ARGB || out_f == AV_PIX_FMT_RGBA)
 		{
-			// YUV420P or UYVY422
-			out_data[1] = out_data[0] + w * h;
-			out_data[2] = out_data[0] + w * h * 5 / 4;
+			const vdec_yuv_matrix& matrix = in_f == AV_PIX_FMT_YUVJ420P ? s_vdec_bt601_full
+				: format->colorMatrixType == CELL_VDEC_COLOR_MATRIX_TYPE_BT709 ? s_vdec_bt709 : s_vdec_bt601;
 
-			if (const int ret = av_image_fill_linesizes(out_line, out_f, w); ret < 0)
-			{
-				fmt::throw_exception("cellVdecGetPictureExt: av_image_fill_linesizes failed (handle=0x%x, seq_id=%d, cmd_id=%d, ret=0x%x): %s", handle, frame.seq_id, frame.cmd_id, ret, utils::av_error_to_string(ret));
-			}
+			vdec_yuv420p_to_rgb32(frame.avf.get(), outBuff.get_ptr(), out_f == AV_PIX_FMT_ARGB, format->alpha, matrix);
+			return CELL_OK;
 		}
 
-		sws_scale(vdec->sws, in_data, in_line, 0, h, out_data, out_line);
+		// YUV420P or UYVY422
+		u8* out_data[4] = { outBuff.get_ptr() };
+		int out_line[4]{};
+
+		out_data[1] = out_data[0] + w * h;
+		out_data[2] = out_data[0] + w * h * 5 / 4;
+
+		if (const int ret = av_image_fill_linesizes(out_line, out_f, w); ret < 0)
+		{
+			fmt::throw_exception("cellVdecGetPictureExt: av_image_fill_linesizes failed (handle=0x%x, seq_id=%d, cmd_id=%d, ret=0x%x): %s", handle, frame.seq_id, frame.cmd_id, ret, utils::av_error_to_string(ret));
+		}
+
+		if (in_f == out_f)
+		{
+			// Same format and range: copy the planes (full range YUVJ420P still needs swscale)
+			av_image_copy(out_data, out_line, const_cast<const u8**>(frame->data), frame->linesize, out_f, w, h);
+			return CELL_OK;
+		}
+
+		vdec->sws = sws_getCachedContext(vdec->sws, w, h, in_f, w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
+
+		sws_scale(vdec->sws, frame->data, frame->linesize, 0, h, out_data, out_line);
 	}
 
 	return CELL_OK;
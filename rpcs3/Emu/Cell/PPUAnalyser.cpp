@@ -5,6 +5,8 @@
 
 #include "PPUOpcodes.h"
 #include "PPUThread.h"
+#include "Crypto/sha1.h"
+#include "Emu/system_utils.hpp"
 
 #include <unordered_set>
 #include "util/yaml.hpp"
@@ -819,6 +821,260 @@ struct reg_state_t
 
 static constexpr reg_state_t s_reg_const_0{ 0, 1 };
 
+// Increment when the analysis output changes for the same input
+static constexpr u32 s_ppu_analysis_cache_version = 2;
+
+// Hash everything the analysis depends on: segment contents (with patches), sections, relocations and arguments
+static void ppu_get_analysis_key(const ppu_module<lv2_obj>& info, u32 lib_toc, u32 entry, u32 sec_end, const std::vector<u32>& applied, const std::vector<u32>& exported_funcs, uchar (&key)[20])
+{
+	sha1_context ctx;
+	sha1_starts(&ctx);
+
+	const auto update = [&](const auto& value)
+	{
+		sha1_update(&ctx, reinterpret_cast<const uchar*>(&value), sizeof(value));
+	};
+
+	const auto update_list = [&](const std::vector<u32>& list)
+	{
+		update(list.size());
+		sha1_update(&ctx, reinterpret_cast<const uchar*>(list.data()), list.size() * sizeof(u32));
+	};
+
+	update(s_ppu_analysis_cache_version);
+	update(lib_toc);
+	update(entry);
+	update(sec_end);
+	update(info.is_relocatable);
+	update_list(applied);
+	update_list(exported_funcs);
+
+	for (const auto& list : {&info.segs, &info.secs})
+	{
+		update(list->size());
+
+		for (const ppu_segment& seg : *list)
+		{
+			update(seg.addr);
+			update(seg.size);
+			update(seg.type);
+			update(seg.flags);
+		}
+	}
+
+	for (const ppu_segment& seg : info.segs)
+	{
+		if (seg.ptr && seg.size)
+		{
+			sha1_update(&ctx, static_cast<const uchar*>(seg.ptr), seg.size);
+		}
+	}
+
+	update(info.relocs.size());
+
+	for (const ppu_reloc& rel : info.relocs)
+	{
+		update(rel.addr);
+		update(rel.type);
+		update(rel.data);
+	}
+
+	update(info.stub_addr_to_constant_state_of_registers.size());
+
+	for (const auto& [addr, states] : info.stub_addr_to_constant_state_of_registers)
+	{
+		update(addr);
+		update(states.size());
+
+		for (const auto& [mask, value] : states)
+		{
+			update(mask.mask);
+			update(value);
+		}
+	}
+
+	sha1_finish(&ctx, key);
+}
+
+static std::string ppu_get_analysis_cache_path(const uchar (&key)[20])
+{
+	return fmt::format("%sppu_analysis/%s.dat", rpcs3::utils::get_cache_dir(), fmt::base57(key));
+}
+
+using ppu_stub_reg_states = decltype(ppu_module<lv2_obj>::stub_addr_to_constant_state_of_registers);
+
+// File format: key, then u32 words: function count, {addr, toc, size, block count, {block addr, block size}...}...
+// Followed by the stub register states after analysis: stub count, {addr, state count, {mask (2 words), value (2 words)}...}...
+static bool ppu_load_analysis_cache(const uchar (&key)[20], std::vector<ppu_function>& funcs, ppu_stub_reg_states& stub_states)
+{
+	const fs::file file(ppu_get_analysis_cache_path(key));
+
+	if (!file)
+	{
+		return false;
+	}
+
+	const std::vector<u8> data = file.to_vector<u8>();
+
+	if (data.size() < sizeof(key) + sizeof(u32) || (data.size() - sizeof(key)) % sizeof(u32) || std::memcmp(data.data(), key, sizeof(key)) != 0)
+	{
+		return false;
+	}
+
+	std::vector<u32> words((data.size() - sizeof(key)) / sizeof(u32));
+	std::memcpy(words.data(), data.data() + sizeof(key), words.size() * sizeof(u32));
+
+	usz pos = 0;
+
+	const auto read = [&](u32& value)
+	{
+		if (pos >= words.size())
+		{
+			return false;
+		}
+
+		value = words[pos++];
+		return true;
+	};
+
+	const auto read64 = [&](u64& value)
+	{
+		u32 lo = 0, hi = 0;
+
+		if (!read(lo) || !read(hi))
+		{
+			return false;
+		}
+
+		value = lo | (u64{hi} << 32);
+		return true;
+	};
+
+	u32 count = 0;
+
+	if (!read(count) || count > words.size())
+	{
+		return false;
+	}
+
+	std::vector<ppu_function> result(count);
+
+	for (ppu_function& func : result)
+	{
+		u32 blocks = 0;
+
+		if (!read(func.addr) || !read(func.toc) || !read(func.size) || !read(blocks) || blocks > words.size() - pos)
+		{
+			return false;
+		}
+
+		for (u32 i = 0; i < blocks; i++)
+		{
+			u32 addr = 0, size = 0;
+
+			if (!read(addr) || !read(size))
+			{
+				return false;
+			}
+
+			func.blocks.emplace(addr, size);
+		}
+	}
+
+	u32 stub_count = 0;
+
+	if (!read(stub_count) || stub_count > words.size() - pos)
+	{
+		return false;
+	}
+
+	ppu_stub_reg_states states;
+
+	for (u32 i = 0; i < stub_count; i++)
+	{
+		u32 addr = 0, state_count = 0;
+
+		if (!read(addr) || !read(state_count) || state_count > (words.size() - pos) / 4)
+		{
+			return false;
+		}
+
+		auto& list = states[addr];
+		list.resize(state_count);
+
+		for (auto& [mask, value] : list)
+		{
+			if (!read64(mask.mask) || !read64(value))
+			{
+				return false;
+			}
+		}
+	}
+
+	if (pos != words.size())
+	{
+		return false;
+	}
+
+	funcs = std::move(result);
+	stub_states = std::move(states);
+	return true;
+}
+
+static void ppu_save_analysis_cache(const uchar (&key)[20], const std::vector<ppu_function>& funcs, const ppu_stub_reg_states& stub_states)
+{
+	std::vector<u32> words;
+	words.reserve(funcs.size() * 6 + 1);
+	words.push_back(::size32(funcs));
+
+	for (const ppu_function& func : funcs)
+	{
+		words.insert(words.end(), {func.addr, func.toc, func.size, ::size32(func.blocks)});
+
+		for (const auto& [addr, size] : func.blocks)
+		{
+			words.insert(words.end(), {addr, size});
+		}
+	}
+
+	// Used by ppu_precompile for the NPDRM KLIC, filled by the analysis
+	words.push_back(::size32(stub_states));
+
+	for (const auto& [addr, states] : stub_states)
+	{
+		words.insert(words.end(), {addr, ::size32(states)});
+
+		for (const auto& [mask, value] : states)
+		{
+			words.insert(words.end(), {static_cast<u32>(mask.mask), static_cast<u32>(mask.mask >> 32), static_cast<u32>(value), static_cast<u32>(value >> 32)});
+		}
+	}
+
+	const std::string path = ppu_get_analysis_cache_path(key);
+
+	if (!fs::create_path(fs::get_parent_dir(path)))
+	{
+		ppu_log.error("Failed to create directory for PPU analysis cache '%s' (%s)", path, fs::g_tls_error);
+		return;
+	}
+
+	fs::pending_file file(path);
+
+	if (!file.file)
+	{
+		ppu_log.error("Failed to create PPU analysis cache '%s' (%s)", path, fs::g_tls_error);
+		return;
+	}
+
+	file.file.write(key, sizeof(key));
+	file.file.write(words.data(), words.size() * sizeof(u32));
+
+	if (!file.commit())
+	{
+		ppu_log.error("Failed to save PPU analysis cache '%s' (%s)", path, fs::g_tls_error);
+	}
+}
+
 template <>
 bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::vector<u32>& applied, const std::vector<u32>& exported_funcs, std::function<bool()> check_aborted)
 {
@@ -827,6 +1083,18 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 		return false;
 	}
 
+	// Analysis results depend only on the input, reuse them from previous boots
+	uchar cache_key[20]{};
+	ppu_get_analysis_key(*this, lib_toc, entry, sec_end, applied, exported_funcs, cache_key);
+
+	if (funcs.empty() && ppu_load_analysis_cache(cache_key, funcs, stub_addr_to_constant_state_of_registers))
+	{
+		ppu_log.notice("Block analysis: %zu blocks (loaded from cache)", funcs.size());
+		return true;
+	}
+
+	const bool save_cache = funcs.empty();
+
 	// Assume first segment is executable
 	const u32 start = segs[0].addr;
 
@@ -3274,5 +3542,11 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 	}
 
 	ppu_log.notice("Block analysis: %zu blocks (%zu enqueued)", funcs.size(), block_queue.size());
+
+	if (save_cache)
+	{
+		ppu_save_analysis_cache(cache_key, funcs, stub_addr_to_constant_state_of_registers);
+	}
+
 	return true;
 }
@@ -2633,9 +2633,20 @@ bool ppu_load_exec(const ppu_exec_object& elf, bool virtual_load, const std::str
 
 	if (!load_libs.empty())
 	{
+		std::vector<fs::file> lib_files;
+
+		for (const auto& name : load_libs)
+		{
+			lib_files.emplace_back(lle_dir + name);
+		}
+
+		// Decrypt concurrently, libraries are still loaded in order
+		const std::vector<fs::file> lib_elfs = decrypt_self_batch(lib_files);
+		usz lib_index = 0;
+
 		for (const auto& name : load_libs)
 		{
-			const ppu_prx_object obj = decrypt_self(fs::file(lle_dir + name));
+			const ppu_prx_object obj = lib_elfs[lib_index++];
 
 			if (obj == elf_error::ok)
 			{
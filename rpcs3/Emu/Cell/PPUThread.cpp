@@ -14,6 +14,7 @@
 #include "Emu/VFS.h"
 #include "Emu/system_progress.hpp"
 #include "Emu/system_utils.hpp"
+#include "Emu/CPU/CPUCompileScheduler.h"
 #include "Emu/System.h"
 #include "PPUThread.h"
 #include "PPUInterpreter.h"
@@ -44,6 +45,7 @@
 #include <llvm/Analysis/LoopAnalysisManager.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Transforms/Scalar/EarlyCSE.h>
+#include <llvm/Support/MemoryBuffer.h>
 #ifdef _MSC_VER
 #pragma warning(pop)
 #else
@@ -2123,6 +2125,7 @@ void ppu_thread::dump_all(std::string& ret) const
 }
 
 extern thread_local std::string(*g_tls_log_prefix)();
+extern thread_local logs::prefix_capture g_tls_log_prefix_capture;
 
 void ppu_thread::cpu_task()
 {
@@ -2859,6 +2862,7 @@ void ppu_thread::fast_call(u32 addr, u64 rtoc, bool is_thread_entry)
 	const auto old_lr = lr;
 	const auto old_func = current_function;
 	const auto old_fmt = g_tls_log_prefix;
+	const auto old_fmt_capture = g_tls_log_prefix_capture;
 
 	interrupt_thread_executing = true;
 	cia = addr;
@@ -2871,7 +2875,27 @@ void ppu_thread::fast_call(u32 addr, u64 rtoc, bool is_thread_entry)
 		lr = old_lr;
 	}
 
-	g_tls_log_prefix = []
+	// Formats the prefix from the captured values (values: id, cia, lr, is HLE)
+	static constexpr auto format_prefix = [](const logs::prefix_args& args) -> std::string
+	{
+		const u64 id = args.values[0];
+		const u64 cia = args.values[1];
+
+		if (args.values[3])
+		{
+			return fmt::format("PPU[0x%x] Thread (%s) [HLE:0x%08x, LR:0x%08x]", id, args.name, cia, args.values[2]);
+		}
+
+		if (!args.module.empty())
+		{
+			return fmt::format("PPU[0x%x] Thread (%s) [%s: 0x%08x]", id, args.name, args.module, cia);
+		}
+
+		return fmt::format("PPU[0x%x] Thread (%s) [0x%08x]", id, args.name, cia);
+	};
+
+	// Captures the current thread state, can be formatted later on another thread
+	static constexpr auto capture_prefix = [](logs::prefix_args& args)
 	{
 		const auto _this = static_cast<ppu_thread*>(get_current_cpu_thread());
 
@@ -2890,21 +2914,33 @@ void ppu_thread::fast_call(u32 addr, u64 rtoc, bool is_thread_entry)
 
 		const auto cia = _this->cia;
 
-		if (_this->current_function && g_fxo->get<ppu_function_manager>().is_func(cia))
-		{
-			return fmt::format("PPU[0x%x] Thread (%s) [HLE:0x%08x, LR:0x%08x]", _this->id, *name_cache.get(), cia, _this->lr);
-		}
-
-		extern const char* get_prx_name_by_cia(u32 addr);
+		args.format = format_prefix;
+		args.name = *name_cache.get();
+		args.values[0] = _this->id;
+		args.values[1] = cia;
+		args.values[2] = _this->lr;
+		args.values[3] = _this->current_function && g_fxo->get<ppu_function_manager>().is_func(cia);
 
-		if (auto name = get_prx_name_by_cia(cia))
+		if (!args.values[3])
 		{
-			return fmt::format("PPU[0x%x] Thread (%s) [%s: 0x%08x]", _this->id, *name_cache.get(), name, cia);
+			extern const char* get_prx_name_by_cia(u32 addr);
+
+			if (auto name = get_prx_name_by_cia(cia))
+			{
+				args.module = name;
+			}
 		}
+	};
 
-		return fmt::format("PPU[0x%x] Thread (%s) [0x%08x]", _this->id, *name_cache.get(), cia);
+	g_tls_log_prefix = []
+	{
+		logs::prefix_args args{};
+		capture_prefix(args);
+		return format_prefix(args);
 	};
 
+	g_tls_log_prefix_capture = {g_tls_log_prefix, capture_prefix};
+
 	auto at_ret = [&]()
 	{
 		if (old_cia)
@@ -2942,6 +2978,7 @@ void ppu_thread::fast_call(u32 addr, u64 rtoc, bool is_thread_entry)
 
 		current_function = old_func;
 		g_tls_log_prefix = old_fmt;
+		g_tls_log_prefix_capture = old_fmt_capture;
 		state -= cpu_flag::ret;
 	};
 
@@ -3470,18 +3507,8 @@ extern bool ppu_stdcx(ppu_thread& ppu, u32 addr, u64 reg_value)
 
 struct jit_core_allocator
 {
-	const s16 thread_count = g_cfg.core.llvm_threads ? std::min<s32>(g_cfg.core.llvm_threads, limit()) : limit();
-
-	// Initialize global semaphore with the max number of threads
-	::semaphore<0x7fff> sem{std::max<s16>(thread_count, 1)};
-
 	// Mutex for special extra-large modules to compile alone
 	shared_mutex shared_mtx;
-
-	static s16 limit()
-	{
-		return static_cast<s16>(std::min<s32>(0x7fff, utils::get_thread_count()));
-	}
 };
 
 #ifdef LLVM_AVAILABLE
@@ -4179,7 +4206,9 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<ppu_
 					}
 
 					// Participate in thread execution limitation (takes a long time)
-					if (std::lock_guard lock(g_fxo->get<jit_core_allocator>().sem); !ovlm->analyse(0, ovlm->entry, ovlm->seg0_code_end, ovlm->applied_patches, std::vector<u32>{}, []()
+					jit_compile_slot slot(jit_priority::speculative);
+
+					if (std::lock_guard lock(slot); !ovlm->analyse(0, ovlm->entry, ovlm->seg0_code_end, ovlm->applied_patches, std::vector<u32>{}, []()
 					{
 						return Emu.IsStopped();
 					}))
@@ -4626,6 +4655,9 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 	// Info to load to main JIT instance (true - compiled)
 	std::vector<std::pair<std::string, bool>> link_workload;
 
+	// Index in link_workload of each workload entry
+	std::vector<u32> workload_link_index;
+
 	// Sync variable to acquire workloads
 	atomic_t<u32> work_cv = 0;
 
@@ -5220,6 +5252,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 
 		// Fill workload list for compilation
 		workload.emplace_back(std::move(obj_name), std::move(part));
+		workload_link_index.push_back(::size32(link_workload) - 1);
 	}
 
 	if (check_only)
@@ -5232,15 +5265,26 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 		g_progr_fknown_bits += file_size;
 	}
 
-	// Create worker threads for compilation
-	if (!workload.empty())
+	// Objects to link, read and decompressed in parallel by the workers (linking stays sequential)
+	std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects(is_being_used_in_emulation ? link_workload.size() : 0);
+
+	// Sync variable to acquire objects to read, compiled objects are read by the thread which compiled them
+	atomic_t<u32> load_cv = 0;
+
+	const usz load_count = std::count_if(link_workload.begin(), link_workload.end(), [&](const auto& entry) { return !objects.empty() && !entry.second; });
+
+	// Create worker threads for compilation and loading
+	if (!workload.empty() || load_count)
 	{
-		// Update progress dialog
-		g_progr_ptotal += ::size32(workload);
+		if (!workload.empty())
+		{
+			// Update progress dialog
+			g_progr_ptotal += ::size32(workload);
 
-		*progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_COMPILING_PPU_MODULES);
+			*progress_dialog = get_localized_string(localized_string_id::PROGRESS_DIALOG_COMPILING_PPU_MODULES);
+		}
 
-		const u32 thread_count = std::min(::size32(workload), rpcs3::utils::get_max_threads());
+		const u32 thread_count = static_cast<u32>(std::min<usz>(workload.size() + load_count, rpcs3::utils::get_max_threads()));
 
 		struct thread_index_allocator
 		{
@@ -5251,17 +5295,26 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 		{
 			atomic_t<u32>& work_cv;
 			std::vector<std::pair<std::string, ppu_module<lv2_obj>>>& workload;
+			const std::vector<u32>& workload_link_index;
+			atomic_t<u32>& load_cv;
+			const std::vector<std::pair<std::string, bool>>& link_workload;
+			std::vector<std::unique_ptr<llvm::MemoryBuffer>>& objects;
 			const ppu_module<lv2_obj>& main_module;
 			const std::string& cache_path;
 			const cpu_thread* cpu;
 
-			std::unique_lock<decltype(jit_core_allocator::sem)> core_lock;
+			std::unique_lock<jit_compile_slot> core_lock;
 
-			thread_op(atomic_t<u32>& work_cv, std::vector<std::pair<std::string, ppu_module<lv2_obj>>>& workload
-				, const cpu_thread* cpu, const ppu_module<lv2_obj>& main_module, const std::string& cache_path, decltype(jit_core_allocator::sem)& sem) noexcept
+			thread_op(atomic_t<u32>& work_cv, std::vector<std::pair<std::string, ppu_module<lv2_obj>>>& workload, const std::vector<u32>& workload_link_index
+				, atomic_t<u32>& load_cv, const std::vector<std::pair<std::string, bool>>& link_workload, std::vector<std::unique_ptr<llvm::MemoryBuffer>>& objects
+				, const cpu_thread* cpu, const ppu_module<lv2_obj>& main_module, const std::string& cache_path, jit_compile_slot& sem) noexcept
 
 				: work_cv(work_cv)
 				, workload(workload)
+				, workload_link_index(workload_link_index)
+				, load_cv(load_cv)
+				, link_workload(link_workload)
+				, objects(objects)
 				, main_module(main_module)
 				, cache_path(cache_path)
 				, cpu(cpu)
@@ -5273,6 +5326,10 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 			thread_op(const thread_op& other) noexcept
 				: work_cv(other.work_cv)
 				, workload(other.workload)
+				, workload_link_index(other.workload_link_index)
+				, load_cv(other.load_cv)
+				, link_workload(other.link_workload)
+				, objects(other.objects)
 				, main_module(other.main_module)
 				, cache_path(other.cache_path)
 				, cpu(other.cpu)
@@ -5301,6 +5358,9 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 						continue;
 					}
 
+					// Let modules needed by running threads compile first
+					core_lock.mutex()->yield();
+
 					// Keep allocating workload
 					const auto& [obj_name, part] = std::as_const(workload)[i];
 
@@ -5321,11 +5381,27 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 
 					{
 						// Use another JIT instance
-						jit_compiler jit2({}, g_cfg.core.llvm_cpu, 0x1);
+						jit_compiler jit2({}, g_cfg.core.llvm_cpu, g_cfg.core.ppu_llvm_object_bundle ? 0x5 : 0x1);
 						ppu_initialize2(jit2, part, cache_path, obj_name);
 					}
 
 					ppu_log.success("LLVM: Compiled module %s", obj_name);
+
+					if (!objects.empty())
+					{
+						objects[workload_link_index[i]] = jit_compiler::load(cache_path + obj_name);
+					}
+				}
+
+				// Read the objects which already existed
+				for (u32 i = load_cv++; i < objects.size(); i = load_cv++)
+				{
+					if (link_workload[i].second || (cpu ? cpu->state.all_of(cpu_flag::exit) : Emu.IsStopped()))
+					{
+						continue;
+					}
+
+					objects[i] = jit_compiler::load(cache_path + link_workload[i].first);
 				}
 
 				core_lock.unlock();
@@ -5335,20 +5411,28 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 		// Prevent watchdog thread from terminating
 		g_watchdog_hold_ctr++;
 
+		// Modules loaded by a running thread block it, boot modules are needed soon, the rest is precompilation
+		jit_compile_slot compile_slot(!is_being_used_in_emulation ? jit_priority::speculative : cpu ? jit_priority::blocking : jit_priority::likely);
+
 		named_thread_group threads(fmt::format("PPUW.%u.", ++g_fxo->get<thread_index_allocator>().index), thread_count
-			, thread_op(work_cv, workload, cpu, info, cache_path, g_fxo->get<jit_core_allocator>().sem)
+			, thread_op(work_cv, workload, workload_link_index, load_cv, link_workload, objects, cpu, info, cache_path, compile_slot)
 			, [&](u32 /*thread_index*/, thread_op& op)
 		{
 			// Allocate "core"
 			op.core_lock.lock();
 
 			// Second check before creating another thread
-			return work_cv < workload.size() && (cpu ? !cpu->state.all_of(cpu_flag::exit) : !Emu.IsStopped());
+			return (work_cv < workload.size() || load_cv < objects.size()) && (cpu ? !cpu->state.all_of(cpu_flag::exit) : !Emu.IsStopped());
 		});
 
 		threads.join();
 
 		g_watchdog_hold_ctr--;
+
+		if (!workload.empty())
+		{
+			ppu_log.notice("LLVM: Compile slots: %s", g_fxo->get<jit_compile_scheduler>().get_stats());
+		}
 	}
 
 	// Initialize compiler instance
@@ -5393,7 +5477,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 				break;
 			}
 
-			if (!failed_to_load && !jits[mod_index / c_moudles_per_jit]->add(cache_path + obj_name))
+			if (!failed_to_load && !jits[mod_index / c_moudles_per_jit]->add(std::move(objects[mod_index]), cache_path + obj_name))
 			{
 				ppu_log.error("LLVM: Failed to load module %s", obj_name);
 				failed_to_load = true;
@@ -8,6 +8,7 @@
 #include "Emu/cache_utils.hpp"
 #include "Emu/IdManager.h"
 #include "Emu/localized_string.h"
+#include "Emu/CPU/CPUCompileScheduler.h"
 #include "Crypto/sha1.h"
 #include "Utilities/StrUtil.h"
 #include "Utilities/JIT.h"
@@ -517,15 +518,6 @@ DECLARE(spu_runtime::g_interpreter_table) = {};
 
 DECLARE(spu_runtime::g_interpreter) = nullptr;
 
-spu_cache::spu_cache(const std::string& loc)
-	: m_file(loc, fs::read + fs::write + fs::create + fs::append)
-{
-}
-
-spu_cache::~spu_cache()
-{
-}
-
 extern void utilize_spu_data_segment(u32 vaddr, const void* ls_data_vaddr, u32 size)
 {
 	if (vaddr % 4)
@@ -596,6 +588,36 @@ extern void utilize_spu_data_segment(u32 vaddr, const void* ls_data_vaddr, u32 s
 	g_fxo->get<spu_cache>().precompile_funcs.push(std::move(obj));
 }
 
+// SPU cache file header (v2)
+struct spu_cache_header
+{
+	le_t<u64> magic;
+	be_t<u32> version;
+	be_t<u32> generation; // Must match between the cache file and its index
+};
+
+// SPU cache record (v2), followed by program data
+struct spu_cache_record
+{
+	be_t<u16> crc;
+	be_t<u16> size;
+	be_t<u32> addr;
+	be_t<u64> hash;
+};
+
+// SPU cache index entry
+struct spu_cache_index_entry
+{
+	be_t<u32> addr;
+	be_t<u32> size;
+	be_t<u64> hash;
+	be_t<u64> offset;
+};
+
+static constexpr u64 c_spu_cache_magic = "SPUCACHE"_u64;
+static constexpr u64 c_spu_index_magic = "SPUINDEX"_u64;
+static constexpr u32 c_spu_cache_version = 2;
+
 // For SPU cache validity check
 static u16 calculate_crc16(const uchar* data, usz length)
 {
@@ -611,6 +633,210 @@ static u16 calculate_crc16(const uchar* data, usz length)
 	return crc;
 }
 
+spu_cache::spu_cache(const std::string& loc)
+	: m_file(loc, fs::read + fs::write + fs::create + fs::append)
+	, m_path(loc)
+	, m_index(std::make_unique<index_t>())
+{
+	if (m_file && !load_index())
+	{
+		m_file.close();
+	}
+}
+
+spu_cache::~spu_cache()
+{
+}
+
+u64 spu_cache::calculate_hash(std::span<const u32> data)
+{
+	sha1_context ctx;
+	u8 output[20];
+
+	sha1_starts(&ctx);
+	sha1_update(&ctx, reinterpret_cast<const u8*>(data.data()), data.size_bytes());
+	sha1_finish(&ctx, output);
+
+	be_t<u64> hash;
+	std::memcpy(&hash, output, sizeof(hash));
+	return hash;
+}
+
+bool spu_cache::write_header()
+{
+	const spu_cache_header header{c_spu_cache_magic, c_spu_cache_version, 0};
+
+	if (!m_file.trunc(0) || m_file.write(&header, sizeof(header)) != sizeof(header))
+	{
+		spu_log.error("SPU Cache: Failed to write header to '%s' (%s)", m_path, fs::g_tls_error);
+		return false;
+	}
+
+	return true;
+}
+
+bool spu_cache::load_index()
+{
+	auto& index = *m_index;
+
+	index.records.clear();
+	index.end = sizeof(spu_cache_header);
+	index.dead_bytes = 0;
+
+	spu_cache_header header{};
+
+	if (m_file.read_at(0, &header, sizeof(header)) != sizeof(header) || header.magic != c_spu_cache_magic || header.version != c_spu_cache_version)
+	{
+		if (m_file.size())
+		{
+			spu_log.error("SPU Cache: Invalid header, discarding '%s'", m_path);
+		}
+
+		if (!write_header())
+		{
+			return false;
+		}
+
+		header = {c_spu_cache_magic, c_spu_cache_version, 0};
+	}
+
+	const u64 file_size = m_file.size();
+
+	std::vector<spu_cache_index_entry> entries;
+
+	m_index_file.open(m_path + ".idx", fs::read + fs::write + fs::create + fs::append);
+
+	if (m_index_file)
+	{
+		spu_cache_header idx_header{};
+
+		if (m_index_file.read_at(0, &idx_header, sizeof(idx_header)) == sizeof(idx_header) && idx_header.magic == c_spu_index_magic &&
+			idx_header.version == c_spu_cache_version && idx_header.generation == header.generation)
+		{
+			m_index_file.read(entries, (m_index_file.size() - sizeof(idx_header)) / sizeof(spu_cache_index_entry), true, sizeof(idx_header));
+		}
+	}
+	else
+	{
+		spu_log.warning("SPU Cache: Failed to open index file (%s), falling back to full scan", fs::g_tls_error);
+	}
+
+	usz valid_entries = 0;
+
+	for (const auto& entry : entries)
+	{
+		const u64 rec_size = sizeof(spu_cache_record) + u64{entry.size} * 4;
+
+		// Entries are stored in file order
+		if (entry.offset < index.end || entry.offset + rec_size > file_size || !entry.size || entry.size > 0xffff)
+		{
+			break;
+		}
+
+		// Gaps contain records which have been rejected during a previous scan
+		index.dead_bytes += entry.offset - index.end;
+		index.end = entry.offset + rec_size;
+
+		if (!index.records.try_emplace(key_t{entry.addr, entry.hash}, record_t{entry.offset, entry.size}).second)
+		{
+			index.dead_bytes += rec_size;
+		}
+
+		valid_entries++;
+	}
+
+	const bool rewrite_index = valid_entries != entries.size() || (m_index_file && m_index_file.size() < sizeof(spu_cache_header));
+
+	// Scan records appended after the last indexed one (or the whole file if the index is unusable)
+	std::vector<spu_cache_index_entry> new_entries;
+	std::vector<u32> data;
+
+	u64 pos = index.end;
+
+	while (pos + sizeof(spu_cache_record) <= file_size)
+	{
+		spu_cache_record rec{};
+
+		if (m_file.read_at(pos, &rec, sizeof(rec)) != sizeof(rec))
+		{
+			break;
+		}
+
+		const u32 size = rec.size;
+		const u32 addr = rec.addr;
+		const u64 next = pos + sizeof(rec) + u64{size} * 4;
+
+		if (!size || utils::add_saturate<u32>(addr, size * 4) > SPU_LS_SIZE || next > file_size)
+		{
+			break;
+		}
+
+		if (!m_file.read(data, size, true, pos + sizeof(rec)))
+		{
+			break;
+		}
+
+		if (rec.crc != std::max<u32>(calculate_crc16(reinterpret_cast<const uchar*>(data.data()), size * 4), 1) || calculate_hash(data) != rec.hash)
+		{
+			index.dead_bytes += next - pos;
+		}
+		else if (index.records.try_emplace(key_t{addr, rec.hash}, record_t{pos, size}).second)
+		{
+			new_entries.push_back({addr, size, rec.hash, pos});
+		}
+		else
+		{
+			index.dead_bytes += next - pos;
+		}
+
+		pos = next;
+	}
+
+	index.end = pos;
+
+	if (pos < file_size)
+	{
+		spu_log.warning("SPU Cache: Discarding %u bytes of truncated data in '%s'", file_size - pos, m_path);
+
+		if (!m_file.trunc(pos))
+		{
+			return false;
+		}
+	}
+
+	if (m_index_file)
+	{
+		if (rewrite_index)
+		{
+			const spu_cache_header idx_header{c_spu_index_magic, c_spu_cache_version, header.generation};
+
+			m_index_file.trunc(0);
+			m_index_file.write(&idx_header, sizeof(idx_header));
+			m_index_file.write(entries.data(), valid_entries * sizeof(spu_cache_index_entry));
+		}
+
+		m_index_file.write(new_entries.data(), new_entries.size() * sizeof(spu_cache_index_entry));
+	}
+
+	if (!new_entries.empty() || rewrite_index)
+	{
+		spu_log.notice("SPU Cache: Indexed %u new programs (%u total) in '%s'", new_entries.size(), index.records.size(), m_path);
+	}
+
+	if (index.dead_bytes && index.dead_bytes >= index.end / 4)
+	{
+		spu_log.notice("SPU Cache: %u bytes of dead data, compacting '%s'", index.dead_bytes, m_path);
+
+		if (!compact())
+		{
+			// Still usable as is
+			spu_log.error("SPU Cache: Failed to compact '%s'", m_path);
+		}
+	}
+
+	return m_file.operator bool();
+}
+
 std::deque<spu_program> spu_cache::get()
 {
 	std::deque<spu_program> result;
@@ -620,7 +846,275 @@ std::deque<spu_program> spu_cache::get()
 		return result;
 	}
 
-	m_file.seek(0);
+	reader_lock lock(m_index->mutex);
+
+	// Read records in file order
+	std::vector<std::pair<key_t, record_t>> records(m_index->records.begin(), m_index->records.end());
+	std::sort(records.begin(), records.end(), FN(x.second.offset < y.second.offset));
+
+	for (const auto& [key, rec] : records)
+	{
+		spu_program res;
+		res.entry_point = key.entry_point;
+		res.lower_bound = key.entry_point;
+
+		if (!m_file.read(res.data, rec.size, true, rec.offset + sizeof(spu_cache_record)))
+		{
+			spu_log.error("SPU Cache: Failed to read program at 0x%x", rec.offset);
+			break;
+		}
+
+		result.emplace_front(std::move(res));
+	}
+
+	return result;
+}
+
+std::vector<spu_cache::program_view> spu_cache::get_views(fs::file_mapping& mapping)
+{
+	std::vector<program_view> result;
+
+	if (!m_file)
+	{
+		return result;
+	}
+
+	reader_lock lock(m_index->mutex);
+
+	mapping = fs::file_mapping(m_file);
+
+	if (!mapping)
+	{
+		spu_log.warning("SPU Cache: Failed to map '%s' (%s)", m_path, fs::g_tls_error);
+		return result;
+	}
+
+	// Newest first
+	std::vector<std::pair<key_t, record_t>> records(m_index->records.begin(), m_index->records.end());
+	std::sort(records.begin(), records.end(), FN(x.second.offset > y.second.offset));
+
+	result.reserve(records.size());
+
+	for (const auto& [key, rec] : records)
+	{
+		const auto data = mapping.view<u32>(rec.offset + sizeof(spu_cache_record), rec.size);
+
+		if (data.size() != rec.size)
+		{
+			spu_log.error("SPU Cache: Failed to map program at 0x%x", rec.offset);
+			continue;
+		}
+
+		result.push_back({key.entry_point, data});
+	}
+
+	return result;
+}
+
+std::optional<spu_program> spu_cache::find(const key_t& key)
+{
+	if (!m_file)
+	{
+		return std::nullopt;
+	}
+
+	reader_lock lock(m_index->mutex);
+
+	const auto found = m_index->records.find(key);
+
+	if (found == m_index->records.end())
+	{
+		return std::nullopt;
+	}
+
+	spu_program res;
+	res.entry_point = key.entry_point;
+	res.lower_bound = key.entry_point;
+
+	if (!m_file.read(res.data, found->second.size, true, found->second.offset + sizeof(spu_cache_record)))
+	{
+		return std::nullopt;
+	}
+
+	return res;
+}
+
+bool spu_cache::contains(const key_t& key) const
+{
+	if (!m_index)
+	{
+		return false;
+	}
+
+	reader_lock lock(m_index->mutex);
+	return m_index->records.contains(key);
+}
+
+usz spu_cache::size() const
+{
+	if (!m_index)
+	{
+		return 0;
+	}
+
+	reader_lock lock(m_index->mutex);
+	return m_index->records.size();
+}
+
+void spu_cache::add(const spu_program& func)
+{
+	if (!m_file)
+	{
+		return;
+	}
+
+	const u32 size = ::size32(func.data);
+
+	if (!size || size > 0xffff)
+	{
+		return;
+	}
+
+	const key_t key{func.entry_point, calculate_hash(func.data)};
+
+	std::lock_guard lock(m_index->mutex);
+
+	auto& index = *m_index;
+
+	if (index.records.contains(key))
+	{
+		// Already cached
+		return;
+	}
+
+	// Add CRC (forced non-zero)
+	const spu_cache_record rec
+	{
+		static_cast<u16>(std::max<u32>(calculate_crc16(reinterpret_cast<const uchar*>(func.data.data()), size * 4), 1)),
+		static_cast<u16>(size),
+		func.entry_point,
+		key.hash
+	};
+
+	const fs::iovec_clone gather[2]
+	{
+		{&rec, sizeof(rec)},
+		{func.data.data(), size * 4}
+	};
+
+	const u64 rec_size = sizeof(rec) + u64{size} * 4;
+
+	// Append data
+	if (const u64 written = m_file.write_gather(gather, 2); written != rec_size)
+	{
+		spu_log.error("SPU Cache: Failed to append program (written=0x%x, %s)", written, fs::g_tls_error);
+		index.end += written;
+		index.dead_bytes += written;
+		return;
+	}
+
+	index.records.emplace(key, record_t{index.end, size});
+
+	if (m_index_file)
+	{
+		const spu_cache_index_entry entry{func.entry_point, size, key.hash, index.end};
+		m_index_file.write(&entry, sizeof(entry));
+	}
+
+	index.end += rec_size;
+}
+
+bool spu_cache::compact()
+{
+	if (!m_file)
+	{
+		return false;
+	}
+
+	std::lock_guard lock(m_index->mutex);
+
+	auto& index = *m_index;
+
+	spu_cache_header header{};
+
+	if (m_file.read_at(0, &header, sizeof(header)) != sizeof(header))
+	{
+		return false;
+	}
+
+	// Invalidate existing index
+	header.generation = header.generation + 1;
+
+	std::vector<std::pair<key_t, record_t>> records(index.records.begin(), index.records.end());
+	std::sort(records.begin(), records.end(), FN(x.second.offset < y.second.offset));
+
+	fs::pending_file temp(m_path);
+
+	if (!temp.file || temp.file.write(&header, sizeof(header)) != sizeof(header))
+	{
+		return false;
+	}
+
+	decltype(index.records) new_records;
+	std::vector<spu_cache_index_entry> entries;
+	std::vector<u8> buf;
+
+	entries.reserve(records.size());
+
+	u64 pos = sizeof(header);
+
+	for (const auto& [key, rec] : records)
+	{
+		const u64 rec_size = sizeof(spu_cache_record) + u64{rec.size} * 4;
+
+		buf.resize(rec_size);
+
+		if (m_file.read_at(rec.offset, buf.data(), rec_size) != rec_size || temp.file.write(buf.data(), rec_size) != rec_size)
+		{
+			return false;
+		}
+
+		new_records.emplace(key, record_t{pos, rec.size});
+		entries.push_back({key.entry_point, rec.size, key.hash, pos});
+		pos += rec_size;
+	}
+
+	// Close the file in order to replace it
+	m_file.close();
+
+	if (!temp.commit())
+	{
+		spu_log.error("SPU Cache: Failed to replace '%s' (%s)", m_path, fs::g_tls_error);
+	}
+	else
+	{
+		index.records = std::move(new_records);
+		index.end = pos;
+		index.dead_bytes = 0;
+
+		if (m_index_file)
+		{
+			const spu_cache_header idx_header{c_spu_index_magic, c_spu_cache_version, header.generation};
+
+			m_index_file.trunc(0);
+			m_index_file.write(&idx_header, sizeof(idx_header));
+			m_index_file.write(entries.data(), entries.size() * sizeof(spu_cache_index_entry));
+		}
+	}
+
+	return m_file.open(m_path, fs::read + fs::write + fs::create + fs::append);
+}
+
+usz spu_cache::import_legacy(const std::string& path)
+{
+	fs::file legacy(path);
+
+	if (!legacy || !m_file)
+	{
+		return 0;
+	}
+
+	const usz old_size = size();
 
 	// TODO: signal truncated or otherwise broken file
 	while (true)
@@ -632,7 +1126,7 @@ std::deque<spu_program> spu_cache::get()
 			be_t<u32> addr;
 		} block_info{};
 
-		if (!m_file.read(block_info))
+		if (!legacy.read(block_info))
 		{
 			break;
 		}
@@ -648,7 +1142,7 @@ std::deque<spu_program> spu_cache::get()
 
 		std::vector<u32> func;
 
-		if (!m_file.read(func, size))
+		if (!legacy.read(func, size))
 		{
 			break;
 		}
@@ -670,34 +1164,10 @@ std::deque<spu_program> spu_cache::get()
 		res.entry_point = addr;
 		res.lower_bound = addr;
 		res.data = std::move(func);
-		result.emplace_front(std::move(res));
-	}
-
-	return result;
-}
-
-void spu_cache::add(const spu_program& func)
-{
-	if (!m_file)
-	{
-		return;
+		add(res);
 	}
 
-	be_t<u32> size = ::size32(func.data);
-	be_t<u32> addr = func.entry_point;
-
-	// Add CRC (forced non-zero)
-	size |= std::max<u32>(calculate_crc16(reinterpret_cast<const uchar*>(func.data.data()), size * 4), 1) << 16;
-
-	const fs::iovec_clone gather[3]
-	{
-		{&size, sizeof(size)},
-		{&addr, sizeof(addr)},
-		{func.data.data(), func.data.size() * 4}
-	};
-
-	// Append data
-	m_file.write_gather(gather, 3);
+	return size() - old_size;
 }
 
 void spu_cache::initialize(bool build_existing_cache)
@@ -720,19 +1190,23 @@ void spu_cache::initialize(bool build_existing_cache)
 	}
 
 	// SPU cache file (version + block size type)
-	const std::string filename = "spu-" + fmt::to_lower(g_cfg.core.spu_block_size.to_string()) + "-v1-tane.dat";
-	const std::string loc = ppu_cache + filename;
-	const std::string loc_debug = fs::get_cache_dir() + "DEBUG/" + filename;
+	const std::string block_size = fmt::to_lower(g_cfg.core.spu_block_size.to_string());
+	const std::string filename = "spu-" + block_size + "-v2-tane.dat";
+	const std::string filename_v1 = "spu-" + block_size + "-v1-tane.dat";
+	const std::string loc_debug_dir = fs::get_cache_dir() + "DEBUG/";
 
 	bool is_debug = false;
 
-	if (fs::is_file(loc_debug))
+	if (fs::is_file(loc_debug_dir + filename) || fs::is_file(loc_debug_dir + filename_v1))
 	{
 		spu_log.success("SPU Cache override applied!");
 		is_debug = true;
 	}
 
-	spu_cache cache(is_debug ? loc_debug : loc);
+	const std::string& loc_dir = is_debug ? loc_debug_dir : ppu_cache;
+	const std::string loc = loc_dir + filename;
+
+	spu_cache cache(loc);
 
 	if (!cache)
 	{
@@ -740,8 +1214,29 @@ void spu_cache::initialize(bool build_existing_cache)
 		return;
 	}
 
-	// Read cache
-	auto func_list = cache.get();
+	if (!cache.size() && fs::is_file(loc_dir + filename_v1))
+	{
+		// Fallback to the unindexed format
+		const usz count = cache.import_legacy(loc_dir + filename_v1);
+		spu_log.success("SPU Cache: Imported %u programs from '%s'", count, loc_dir + filename_v1);
+	}
+
+	// Map cache, programs are only copied when a worker picks them up
+	fs::file_mapping cache_mapping;
+	std::deque<spu_program> cache_storage;
+	std::vector<spu_cache::program_view> func_list = cache.get_views(cache_mapping);
+
+	if (!cache_mapping && cache.size())
+	{
+		// Fallback to reading the whole cache
+		cache_storage = cache.get();
+
+		for (const spu_program& func : cache_storage)
+		{
+			func_list.push_back({func.entry_point, func.data});
+		}
+	}
+
 	atomic_t<usz> fnext{};
 	atomic_t<u8> fail_flag{0};
 
@@ -863,6 +1358,11 @@ void spu_cache::initialize(bool build_existing_cache)
 
 		compiler->init();
 
+		// Functions from the SPU cache are likely to run, embedded SPU images are compiled speculatively
+		jit_compile_slot cache_slot(jit_priority::likely);
+		jit_compile_slot precompile_slot(jit_priority::speculative);
+		std::unique_lock core_lock(cache_slot);
+
 		// Counter for error reporting
 		u32 logged_error = 0;
 
@@ -880,27 +1380,25 @@ void spu_cache::initialize(bool build_existing_cache)
 		// Build functions
 		for (; func_i < func_list.size(); func_i = fnext++, (showing_progress ? g_progr_pdone : pending_progress) += build_existing_cache ? 1 : 0)
 		{
-			const spu_program& func = std::as_const(func_list)[func_i];
-
 			if (Emu.IsStopped() || fail_flag)
 			{
 				continue;
 			}
 
+			cache_slot.yield();
+
+			const spu_cache::program_view& view = func_list[func_i];
+
+			spu_program func;
+			func.entry_point = view.entry_point;
+			func.lower_bound = view.entry_point;
+			func.data.assign(view.data.begin(), view.data.end());
+
 			// Get data start
 			const u32 start = func.lower_bound;
 			const u32 size0 = ::size32(func.data);
 
-			be_t<u64> hash_start;
-			{
-				sha1_context ctx;
-				u8 output[20];
-
-				sha1_starts(&ctx);
-				sha1_update(&ctx, reinterpret_cast<const u8*>(func.data.data()), func.data.size() * 4);
-				sha1_finish(&ctx, output);
-				std::memcpy(&hash_start, output, sizeof(hash_start));
-			}
+			const be_t<u64> hash_start = spu_cache::calculate_hash(func.data);
 
 			// Check hash against allowed bounds
 			const bool inverse_bounds = g_cfg.core.spu_llvm_lower_bound > g_cfg.core.spu_llvm_upper_bound;
@@ -963,6 +1461,9 @@ void spu_cache::initialize(bool build_existing_cache)
 			}
 		}
 
+		core_lock.unlock();
+		core_lock = std::unique_lock(precompile_slot);
+
 		u32 last_sec_idx = umax;
 
 		for (func_i = data_indexer++;; func_i = data_indexer++, (showing_progress ? g_progr_pdone : pending_progress) += build_existing_cache ? 1 : 0)
@@ -1002,6 +1503,8 @@ void spu_cache::initialize(bool build_existing_cache)
 				continue;
 			}
 
+			precompile_slot.yield();
+
 			if (last_sec_idx != sec_idx)
 			{
 				if (last_sec_idx != umax)
@@ -1160,6 +1663,7 @@ void spu_cache::initialize(bool build_existing_cache)
 	}
 
 	spu_log.notice("SPU Runtime: Workers built %u programs.", built_total);
+	spu_log.notice("SPU Runtime: Compile slots: %s", g_fxo->get<jit_compile_scheduler>().get_stats());
 
 	if (Emu.IsStopped())
 	{
@@ -1182,12 +1686,12 @@ void spu_cache::initialize(bool build_existing_cache)
 			std::string dump;
 			dump.reserve(10'000'000);
 
-			std::map<std::span<u8>, spu_program*, span_less<u8>> sorted;
+			std::map<std::span<const u8>, const spu_cache::program_view*, span_less<const u8>> sorted;
 
 			for (auto&& f : func_list)
 			{
 				// Interpret as a byte string
-				std::span<u8> data = {reinterpret_cast<u8*>(f.data.data()), f.data.size() * sizeof(u32)};
+				std::span<const u8> data = {reinterpret_cast<const u8*>(f.data.data()), f.data.size_bytes()};
 
 				sorted[data] = &f;
 			}
@@ -7580,6 +8084,9 @@ struct spu_llvm_worker
 
 		bool set_relax_flag = false;
 
+		// Running SPU threads execute slower code until this is done
+		jit_compile_slot slot(jit_priority::blocking);
+
 		for (auto slice = registered.pop_all();; [&]
 		{
 			if (slice)
@@ -7636,6 +8143,8 @@ struct spu_llvm_worker
 
 			const auto& func = *prog->second;
 
+			std::lock_guard lock(slot);
+
 			// Get data start
 			const u32 start = func.lower_bound;
 			const u32 size0 = ::size32(func.data);
@@ -7724,6 +8233,11 @@ struct spu_llvm
 		// To compile (hash -> item)
 		std::unordered_multimap<u64, spu_item*, value_hash<u64>> enqueued;
 
+		// Blocks running in the first tier until they become hot
+		std::vector<std::pair<u64, spu_item*>> cold;
+
+		const u64 threshold = g_cfg.core.spu_llvm_promotion_threshold;
+
 		// Mini-profiler (hash -> number of occurrences)
 		std::unordered_map<u64, atomic_t<u64>, value_hash<u64>> samples;
 
@@ -7787,17 +8301,47 @@ struct spu_llvm
 		auto workers_ptr = m_workers.load();
 		auto& workers = *workers_ptr;
 
+		const auto enqueue = [&](const std::pair<u64, spu_item*>& pair)
+		{
+			enqueued.emplace(pair);
+
+			// Interrupt and kick profiler thread
+			const auto lock = prof_mutex.init_always([&]{});
+
+			// Register new blocks to collect samples
+			samples.emplace(pair.first, 0);
+		};
+
+		u32 scan_countdown = 0;
+
 		while (thread_ctrl::state() != thread_state::aborting)
 		{
 			for (const auto& pair : registered.pop_all())
 			{
-				enqueued.emplace(pair);
+				if (threshold && pair.second->hits < threshold)
+				{
+					cold.emplace_back(pair);
+					continue;
+				}
+
+				enqueue(pair);
+			}
+
+			// Promote hot blocks (checked when idle or periodically)
+			if (!cold.empty() && (enqueued.empty() || !scan_countdown--))
+			{
+				std::erase_if(cold, [&](const std::pair<u64, spu_item*>& pair)
+				{
+					if (pair.second->hits < threshold)
+					{
+						return false;
+					}
 
-				// Interrupt and kick profiler thread
-				const auto lock = prof_mutex.init_always([&]{});
+					enqueue(pair);
+					return true;
+				});
 
-				// Register new blocks to collect samples
-				samples.emplace(pair.first, 0);
+				scan_countdown = 64;
 			}
 
 			if (enqueued.empty())
@@ -7814,9 +8358,9 @@ struct spu_llvm
 					}
 				}
 
-				// Interrupt profiler thread and put it to sleep
+				// Interrupt profiler thread and put it to sleep (poll execution counters of cold blocks)
 				static_cast<void>(prof_mutex.reset());
-				thread_ctrl::wait_on(registered.get_wait_atomic(), 0);
+				thread_ctrl::wait_on(registered.get_wait_atomic(), 0, cold.empty() ? u64{umax} : 20'000);
 				std::fill(notify_compile.begin(), notify_compile.end(), 0); // Reset notification flags
 				notify_compile_count = 0;
 				compile_pending = 0;
@@ -7950,8 +8494,11 @@ struct spu_fast : public spu_recompiler_base
 			fs::write_file(m_spurt->get_cache_path() + "spu.log", fs::create + fs::write + fs::append, log);
 		}
 
+		// Execution counter is only read by the SPU LLVM thread when promotion is enabled
+		const bool count_hits = g_cfg.core.spu_llvm_promotion_threshold != 0;
+
 		// Allocate executable area with necessary size
-		const auto result = jit_runtime::alloc(22 + 1 + 9 + ::size32(func.data) * (16 + 16) + 36 + 47, 16);
+		const auto result = jit_runtime::alloc(22 + 1 + 9 + (count_hits ? 13 : 0) + ::size32(func.data) * (16 + 16) + 36 + 47, 16);
 
 		if (!result)
 		{
@@ -8081,6 +8628,21 @@ struct spu_fast : public spu_recompiler_base
 		std::memcpy(raw, &blc_off, 4);
 		raw += 4;
 
+		if (count_hits)
+		{
+			// Count executions for promotion to LLVM: mov rax, &add_loc->hits
+			*raw++ = 0x48;
+			*raw++ = 0xb8;
+			const u64 hits_ptr = reinterpret_cast<u64>(&add_loc->hits);
+			std::memcpy(raw, &hits_ptr, 8);
+			raw += 8;
+
+			// inc qword ptr [rax]
+			*raw++ = 0x48;
+			*raw++ = 0xff;
+			*raw++ = 0x00;
+		}
+
 		// lea r14, [local epilogue]
 		*raw++ = 0x4c;
 		*raw++ = 0x8d;
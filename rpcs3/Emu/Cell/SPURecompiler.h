@@ -3,18 +3,79 @@
 #include "Utilities/File.h"
 #include "Utilities/lockless.h"
 #include "Utilities/address_range.h"
+#include "Utilities/mutex.h"
 #include "SPUThread.h"
 #include <vector>
 #include <bitset>
 #include <memory>
 #include <string>
 #include <deque>
+#include <optional>
+#include <span>
+#include <unordered_map>
 
 // Helper class
 class spu_cache
 {
+public:
+	// Lookup key of a cached program
+	struct key_t
+	{
+		u32 entry_point;
+		u64 hash; // Content hash (see calculate_hash)
+
+		bool operator==(const key_t&) const noexcept = default;
+	};
+
+	struct key_hash
+	{
+		usz operator()(const key_t& key) const noexcept
+		{
+			return static_cast<usz>(key.hash ^ (u64{key.entry_point} << 40));
+		}
+	};
+
+	// Read-only view of cached program data (no copy)
+	struct program_view
+	{
+		u32 entry_point;
+		std::span<const u32> data;
+	};
+
+	// Location of a program record in the cache file
+	struct record_t
+	{
+		u64 offset;
+		u32 size; // In instructions
+	};
+
+private:
+	struct index_t
+	{
+		shared_mutex mutex;
+
+		std::unordered_map<key_t, record_t, key_hash> records;
+
+		// End of the last valid record (next append position)
+		u64 end = 0;
+
+		// Bytes occupied by duplicate or broken records
+		u64 dead_bytes = 0;
+	};
+
 	fs::file m_file;
 
+	// Sidecar index file (one entry per record)
+	fs::file m_index_file;
+
+	std::string m_path;
+
+	std::unique_ptr<index_t> m_index;
+
+	bool load_index();
+
+	bool write_header();
+
 public:
 	spu_cache() = default;
 
@@ -33,8 +94,27 @@ public:
 
 	std::deque<struct spu_program> get();
 
+	// Map the file and return program views in the same order as get()
+	std::vector<program_view> get_views(fs::file_mapping& mapping);
+
+	// Load a single program without scanning the file
+	std::optional<struct spu_program> find(const key_t& key);
+
+	bool contains(const key_t& key) const;
+
+	usz size() const;
+
+	// Append program if it is not already present
 	void add(const struct spu_program& func);
 
+	// Rewrite the file without duplicate or broken records
+	bool compact();
+
+	// Import programs from the unindexed v1 format
+	usz import_legacy(const std::string& path);
+
+	static u64 calculate_hash(std::span<const u32> data);
+
 	static void initialize(bool build_existing_cache = true);
 
 	struct precompile_data_t
@@ -80,6 +160,9 @@ public:
 	atomic_t<u8> cached = false;
 	atomic_t<u8> logged = false;
 
+	// Execution counter of the first tier code (approximate, incremented without lock)
+	atomic_t<u64> hits = 0;
+
 	spu_item(spu_program&& data)
 		: data(std::move(data))
 	{
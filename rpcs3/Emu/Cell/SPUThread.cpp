@@ -1340,6 +1340,7 @@ void spu_thread::cpu_return()
 }
 
 extern thread_local std::string(*g_tls_log_prefix)();
+extern thread_local logs::prefix_capture g_tls_log_prefix_capture;
 
 void spu_thread::cpu_task()
 {
@@ -1360,7 +1361,22 @@ void spu_thread::cpu_task()
 
 	gv_set_zeroing_denormals();
 
-	g_tls_log_prefix = []
+	// Formats the prefix from the captured values (values: type, lv2_id, pc, block hash)
+	static constexpr auto format_prefix = [](const logs::prefix_args& args) -> std::string
+	{
+		const auto type = static_cast<spu_type>(args.values[0]);
+		const auto type_name = type >= spu_type::raw ? type == spu_type::isolated ? "Iso" : "Raw" : "";
+
+		if (u64 hash = args.values[3])
+		{
+			return fmt::format("%sSPU[0x%07x] Thread (%s) [0x%05x: %s]", type_name, args.values[1], args.name, args.values[2], spu_block_hash_short{hash});
+		}
+
+		return fmt::format("%sSPU[0x%07x] Thread (%s) [0x%05x]", type_name, args.values[1], args.name, args.values[2]);
+	};
+
+	// Captures the current thread state, can be formatted later on another thread
+	static constexpr auto capture_prefix = [](logs::prefix_args& args)
 	{
 		const auto cpu = static_cast<spu_thread*>(get_current_cpu_thread());
 
@@ -1377,16 +1393,23 @@ void spu_thread::cpu_task()
 			});
 		}
 
-		const auto type = cpu->get_type();
-
-		if (u64 hash = cpu->block_hash)
-		{
-			return fmt::format("%sSPU[0x%07x] Thread (%s) [0x%05x: %s]", type >= spu_type::raw ? type == spu_type::isolated ? "Iso" : "Raw" : "", cpu->lv2_id, *name_cache.get(), cpu->pc, spu_block_hash_short{atomic_storage<u64>::load(hash)});
-		}
+		args.format = format_prefix;
+		args.name = *name_cache.get();
+		args.values[0] = static_cast<u64>(cpu->get_type());
+		args.values[1] = cpu->lv2_id;
+		args.values[2] = cpu->pc;
+		args.values[3] = cpu->block_hash;
+	};
 
-		return fmt::format("%sSPU[0x%07x] Thread (%s) [0x%05x]", type >= spu_type::raw ? type == spu_type::isolated ? "Iso" : "Raw" : "", cpu->lv2_id, *name_cache.get(), cpu->pc);
+	g_tls_log_prefix = []
+	{
+		logs::prefix_args args{};
+		capture_prefix(args);
+		return format_prefix(args);
 	};
 
+	g_tls_log_prefix_capture = {g_tls_log_prefix, capture_prefix};
+
 	if (get_type() == spu_type::threaded)
 	{
 		// Update thread name (spu_thread::lv2_id update)
@@ -13,6 +13,7 @@
 #include "Emu/IdManager.h"
 #include "Emu/system_utils.hpp"
 #include "Emu/Cell/lv2/sys_process.h"
+#include "Emu/io_thread_pool.h"
 
 #include <filesystem>
 #include <span>
@@ -20,6 +21,11 @@
 
 LOG_CHANNEL(sys_fs);
 
+// Reads and writes of at least this size keep several host requests in flight
+constexpr u64 fs_parallel_io_size = 4 * 1024 * 1024;
+
+constexpr u64 fs_parallel_io_chunk = 1024 * 1024;
+
 lv2_fs_mount_point g_mp_sys_dev_usb{"/dev_usb", "CELL_FS_FAT", "CELL_FS_IOS:USB_MASS_STORAGE", 512, 0x100, 4096, lv2_mp_flag::no_uid_gid};
 lv2_fs_mount_point g_mp_sys_dev_dvd{"/dev_ps2disc", "CELL_FS_ISO9660", "CELL_FS_IOS:PATA1_BDVD_DRIVE", 2048, 0x100, 32768, lv2_mp_flag::read_only + lv2_mp_flag::no_uid_gid, &g_mp_sys_dev_usb};
 lv2_fs_mount_point g_mp_sys_dev_bdvd{"/dev_bdvd", "CELL_FS_ISO9660", "CELL_FS_IOS:PATA0_BDVD_DRIVE", 2048, 0x4D955, 2048, lv2_mp_flag::read_only + lv2_mp_flag::no_uid_gid, &g_mp_sys_dev_dvd};
@@ -410,7 +416,54 @@ u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size, u64 opt
 	return result;
 }
 
-u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
+// The data is contiguous up to the first short chunk
+static u64 fs_get_chunks_result(const std::vector<u64>& chunk_results, u64 size)
+{
+	u64 result = 0;
+
+	for (usz i = 0; i < chunk_results.size(); i++)
+	{
+		result += chunk_results[i];
+
+		if (chunk_results[i] < std::min<u64>(size - i * fs_parallel_io_chunk, fs_parallel_io_chunk))
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
+u64 lv2_file::op_read(vm::ptr<void> buf, u64 size, u64 opt_pos) const
+{
+	if (opt_pos == umax || size < fs_parallel_io_size || type != lv2_file_type::regular)
+	{
+		return op_read(file, buf, size, opt_pos);
+	}
+
+	// Don't queue chunks past the end of file
+	const u64 file_size = file.size();
+	size = std::min<u64>(size, file_size > opt_pos ? file_size - opt_pos : 0);
+
+	std::vector<u64> chunk_results(utils::aligned_div(size, fs_parallel_io_chunk));
+
+	const auto read_chunk = [&](u32 index)
+	{
+		const u64 offset = index * fs_parallel_io_chunk;
+		const u64 chunk_size = std::min<u64>(size - offset, fs_parallel_io_chunk);
+
+		chunk_results[index] = op_read(file, vm::ptr<void>::make(buf.addr() + static_cast<u32>(offset)), chunk_size, opt_pos + offset);
+	};
+
+	if (!g_fxo->get<io_thread_pool>().try_run(::size32(chunk_results), read_chunk))
+	{
+		return op_read(file, buf, size, opt_pos);
+	}
+
+	return fs_get_chunks_result(chunk_results, size);
+}
+
+u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size, u64 opt_pos)
 {
 	// Copy data to intermediate buffer (avoid passing vm pointer to a native API)
 	std::vector<uchar> local_buf(std::min<u64>(size, 65536));
@@ -421,7 +474,7 @@ u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 	{
 		const u64 block = std::min<u64>(size - result, local_buf.size());
 		std::memcpy(local_buf.data(), static_cast<const uchar*>(buf.get_ptr()) + result, block);
-		const u64 nwrite = file.write(+local_buf.data(), block);
+		const u64 nwrite = (opt_pos == umax ? file.write(+local_buf.data(), block) : file.write_at(opt_pos + result, +local_buf.data(), block));
 		result += nwrite;
 
 		if (nwrite < block)
@@ -433,6 +486,41 @@ u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 	return result;
 }
 
+u64 lv2_file::op_write(vm::cptr<void> buf, u64 size, u64 opt_pos) const
+{
+	// Other file implementations do not support concurrent positional writes
+	if (size < fs_parallel_io_size || type != lv2_file_type::regular || file.get_handle() == fs::file{}.get_handle())
+	{
+		return op_write(file, buf, size, opt_pos);
+	}
+
+	const u64 pos = opt_pos == umax ? file.pos() : opt_pos;
+
+	std::vector<u64> chunk_results(utils::aligned_div(size, fs_parallel_io_chunk));
+
+	const auto write_chunk = [&](u32 index)
+	{
+		const u64 offset = index * fs_parallel_io_chunk;
+		const u64 chunk_size = std::min<u64>(size - offset, fs_parallel_io_chunk);
+
+		chunk_results[index] = op_write(file, vm::cptr<void>::make(buf.addr() + static_cast<u32>(offset)), chunk_size, pos + offset);
+	};
+
+	if (!g_fxo->get<io_thread_pool>().try_run(::size32(chunk_results), write_chunk))
+	{
+		return op_write(file, buf, size, opt_pos);
+	}
+
+	const u64 result = fs_get_chunks_result(chunk_results, size);
+
+	if (opt_pos == umax)
+	{
+		file.seek(pos + result);
+	}
+
+	return result;
+}
+
 lv2_file::lv2_file(utils::serial& ar)
 	: lv2_fs_object(ar, false)
 	, mode(ar)
@@ -1125,7 +1213,10 @@ error_code sys_fs_read(ppu_thread& ppu, u32 fd, vm::ptr<void> buf, u64 nbytes, v
 		lv2_obj::sleep(ppu);
 	}
 
-	std::unique_lock lock(file->mp->mutex);
+	// Writers, seeks and closes take the mount point lock exclusively
+	// Reads on other descriptors of the same mount point may proceed in parallel
+	std::shared_lock lock(file->mp->mutex);
+	std::unique_lock pos_lock(file->pos_mutex);
 
 	if (!file->file)
 	{
@@ -1138,8 +1229,12 @@ error_code sys_fs_read(ppu_thread& ppu, u32 fd, vm::ptr<void> buf, u64 nbytes, v
 		return CELL_EIO;
 	}
 
-	const u64 read_bytes = file->op_read(buf, nbytes);
-	const bool failure = !read_bytes && file->file.pos() < file->file.size();
+	const u64 pos = file->file.pos();
+	const u64 read_bytes = file->op_read(buf, nbytes, pos);
+	file->file.seek(pos + read_bytes);
+
+	const bool failure = !read_bytes && pos < file->file.size();
+	pos_lock.unlock();
 	lock.unlock();
 	ppu.check_state();
 
@@ -2027,23 +2122,11 @@ error_code sys_fs_fcntl(ppu_thread& ppu, u32 fd, u32 op, vm::ptr<void> _arg, u32
 			return CELL_EBUSY;
 		}
 
-		u64 old_pos = umax;
 		const u64 op_pos = arg->offset;
 
-		if (op == 0x8000000b)
-		{
-			old_pos = file->file.pos();
-			file->file.seek(op_pos);
-		}
-
 		arg->out_size = op == 0x8000000a
 			? file->op_read(arg->buf, arg->size, op_pos)
-			: file->op_write(arg->buf, arg->size);
-
-		if (op == 0x8000000b)
-		{
-			ensure(old_pos == file->file.seek(old_pos));
-		}
+			: file->op_write(arg->buf, arg->size, op_pos);
 
 		// TODO: EDATA corruption detection
 
@@ -289,6 +289,9 @@ struct lv2_file final : lv2_fs_object
 	// Stream lock
 	atomic_t<u32> lock{0};
 
+	// Serializes reads at the file position, which only hold the mount point lock as a reader
+	shared_mutex pos_mutex;
+
 	// Some variables for convenience of data restoration
 	struct save_restore_t
 	{
@@ -342,18 +345,14 @@ struct lv2_file final : lv2_fs_object
 	// File reading with intermediate buffer
 	static u64 op_read(const fs::file& file, vm::ptr<void> buf, u64 size, u64 opt_pos = umax);
 
-	u64 op_read(vm::ptr<void> buf, u64 size, u64 opt_pos = umax) const
-	{
-		return op_read(file, buf, size, opt_pos);
-	}
+	// Large positional reads of regular files are split into chunks read by the I/O thread pool
+	u64 op_read(vm::ptr<void> buf, u64 size, u64 opt_pos = umax) const;
 
-	// File writing with intermediate buffer
-	static u64 op_write(const fs::file& file, vm::cptr<void> buf, u64 size);
+	// File writing with intermediate buffer (the file position is left untouched with opt_pos)
+	static u64 op_write(const fs::file& file, vm::cptr<void> buf, u64 size, u64 opt_pos = umax);
 
-	u64 op_write(vm::cptr<void> buf, u64 size) const
-	{
-		return op_write(file, buf, size);
-	}
+	// Large writes of native regular files are split into chunks written by the I/O thread pool
+	u64 op_write(vm::cptr<void> buf, u64 size, u64 opt_pos = umax) const;
 
 	// For MSELF support
 	struct file_view;
@@ -10,7 +10,9 @@
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/Cell/SPURecompiler.h"
 #include "Emu/perf_meter.hpp"
+#include "Emu/savestate_utils.hpp"
 #include <deque>
+#include <set>
 #include <span>
 
 #include "util/vm.hpp"
@@ -1644,6 +1646,21 @@ namespace vm
 		}
 	}
 
+	void block_t::get_preallocated_memory(std::vector<std::pair<u32, u32>>& regions)
+	{
+		auto& m_map = (m.*block_map)();
+
+		if (flags & preallocated)
+		{
+			const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
+
+			for (const auto& [addr, shm] : m_map)
+			{
+				regions.emplace_back(addr + guard_size, shm.first - guard_size * 2);
+			}
+		}
+	}
+
 	u32 block_t::get_shm_addr(const std::shared_ptr<utils::shm>& shared)
 	{
 		auto& m_map = (m.*block_map)();
@@ -1755,6 +1772,186 @@ namespace vm
 		ar.breathe();
 	}
 
+	// Incremental savestates: memory of a full savestate kept as the base, following savestates only store pages which differ from it
+	struct savestate_base_t
+	{
+		std::string path;
+
+		// Region key -> position of the region in the base file, hashes of its pages
+		std::unordered_map<u64, std::pair<usz, std::vector<u64>>> regions;
+	};
+
+	enum class savestate_memory_mode : u8
+	{
+		full,
+		full_base, // A copy of the savestate is the base of incremental savestates
+		incremental,
+	};
+
+	// Rebuilt by vm::load() from the savestate or its base
+	static savestate_base_t s_savestate_base;
+
+	// State of the current vm::save() and vm::load()
+	static savestate_memory_mode s_memory_mode = savestate_memory_mode::full;
+	static std::shared_ptr<utils::serial> s_load_base;
+
+	// Key of memory regions in savestates: address of block allocations, index of shared memory
+	static u64 make_region_key(u32 addr, bool is_shared)
+	{
+		return (u64{is_shared} << 32) | addr;
+	}
+
+	u64 hash_memory_page(const u8* ptr)
+	{
+		// XXH64-like rounds on four lanes (a difference in a single word always changes the result)
+		constexpr u64 prime1 = 0x9E3779B185EBCA87;
+		constexpr u64 prime2 = 0xC2B2AE3D27D4EB4F;
+
+		u64 acc[4]{prime1 + prime2, prime2, 0, 0 - prime1};
+
+		for (usz i = 0; i < 4096; i += sizeof(acc))
+		{
+			for (usz j = 0; j < std::size(acc); j++)
+			{
+				acc[j] += read_from_ptr<u64>(ptr, i + j * sizeof(u64)) * prime2;
+				acc[j] = std::rotl(acc[j], 31) * prime1;
+			}
+		}
+
+		return std::rotl(acc[0], 1) + std::rotl(acc[1], 7) + std::rotl(acc[2], 12) + std::rotl(acc[3], 18);
+	}
+
+	static u64 hash_page_hashes(const std::vector<u64>& hashes)
+	{
+		u64 result = hashes.size();
+
+		for (u64 hash : hashes)
+		{
+			result = std::rotl(result ^ hash, 27) * 0x9E3779B185EBCA87 + 0x85EBCA77C2B2AE63;
+		}
+
+		return result;
+	}
+
+	static void serialize_memory_region(utils::serial& ar, u8* ptr, usz size, u64 key)
+	{
+		const usz page_count = size / 4096;
+
+		if (ar.is_writing())
+		{
+			if (s_memory_mode != savestate_memory_mode::incremental)
+			{
+				serialize_memory_bytes(ar, ptr, size);
+				return;
+			}
+
+			const auto found = s_savestate_base.regions.find(key);
+
+			if (found == s_savestate_base.regions.end() || found->second.second.size() != page_count)
+			{
+				// Not found in the base
+				ar(usz{umax});
+				serialize_memory_bytes(ar, ptr, size);
+				return;
+			}
+
+			const auto& [base_pos, hashes] = found->second;
+
+			// Bitmap of changed pages followed by their contents
+			std::vector<u8> bit_array(utils::aligned_div<usz>(page_count, 8));
+
+			for (usz i = 0; i < page_count; i++)
+			{
+				if (hash_memory_page(ptr + i * 4096) != hashes[i])
+				{
+					bit_array[i / 8] |= 1u << (i % 8);
+				}
+			}
+
+			ar(base_pos, hash_page_hashes(hashes));
+			ar(std::span<u8>(bit_array.data(), bit_array.size()));
+
+			for (usz i = 0; i < page_count; i++)
+			{
+				if (bit_array[i / 8] & (1u << (i % 8)))
+				{
+					ar(std::span<u8>(ptr + i * 4096, 4096));
+					ar.breathe();
+				}
+			}
+
+			return;
+		}
+
+		// Record the contents of the base while loading (for following incremental savestates)
+		auto record_base = [&](usz base_pos)
+		{
+			auto& [pos, hashes] = s_savestate_base.regions[key];
+
+			pos = base_pos;
+			hashes.resize(page_count);
+
+			for (usz i = 0; i < page_count; i++)
+			{
+				hashes[i] = hash_memory_page(ptr + i * 4096);
+			}
+
+			return hash_page_hashes(hashes);
+		};
+
+		if (s_memory_mode == savestate_memory_mode::full)
+		{
+			serialize_memory_bytes(ar, ptr, size);
+			return;
+		}
+
+		if (s_memory_mode == savestate_memory_mode::full_base)
+		{
+			// The base is a copy of this savestate
+			const usz base_pos = ar.pos;
+			serialize_memory_bytes(ar, ptr, size);
+			record_base(base_pos);
+			return;
+		}
+
+		const usz base_pos = ar.pop<usz>();
+
+		if (base_pos == umax)
+		{
+			serialize_memory_bytes(ar, ptr, size);
+			return;
+		}
+
+		const u64 base_hash = ar.pop<u64>();
+
+		if (s_load_base->pos > base_pos)
+		{
+			// Regions are mostly in the same order, reopen the file for the rare backwards seek
+			s_load_base = make_savestate_reader(s_savestate_base.path);
+			ensure(s_load_base);
+		}
+
+		s_load_base->seek_pos(base_pos, true);
+		serialize_memory_bytes(*s_load_base, ptr, size);
+
+		if (record_base(base_pos) != base_hash)
+		{
+			fmt::throw_exception("Incremental savestate does not match its base (path='%s', region=0x%x)", s_savestate_base.path, key);
+		}
+
+		std::vector<u8> bit_array(utils::aligned_div<usz>(page_count, 8));
+		ar(std::span<u8>(bit_array.data(), bit_array.size()));
+
+		for (usz i = 0; i < page_count; i++)
+		{
+			if (bit_array[i / 8] & (1u << (i % 8)))
+			{
+				ar(std::span<u8>(ptr + i * 4096, 4096));
+				ar.breathe();
+			}
+		}
+	}
+
 	void block_t::save(utils::serial& ar, std::map<utils::shm*, usz>& shared)
 	{
 		auto& m_map = (m.*block_map)();
@@ -1782,7 +1979,7 @@ namespace vm
 
 				// Save raw binary image
 				const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
-				serialize_memory_bytes(ar, vm::get_super_ptr<u8>(addr + guard_size), shm.first - guard_size * 2);
+				serialize_memory_region(ar, vm::get_super_ptr<u8>(addr + guard_size), shm.first - guard_size * 2, make_region_key(addr + guard_size, false));
 			}
 			else
 			{
@@ -1857,7 +2054,7 @@ namespace vm
 			{
 				// Load binary image
 				const u32 guard_size = flags & stack_guarded ? 0x1000 : 0;
-				serialize_memory_bytes(ar, vm::get_super_ptr<u8>(addr0 + guard_size), size0 - guard_size * 2);
+				serialize_memory_region(ar, vm::get_super_ptr<u8>(addr0 + guard_size), size0 - guard_size * 2, make_region_key(addr0 + guard_size, false));
 			}
 		}
 	}
@@ -2278,6 +2475,8 @@ namespace vm
 			g_locations.clear();
 		}
 
+		s_savestate_base = {};
+
 		utils::memory_decommit(g_exec_addr, 0x200000000);
 		utils::memory_decommit(g_stat_addr, 0x100000000);
 
@@ -2292,8 +2491,25 @@ namespace vm
 		std::memset(g_range_lock_bits, 0, sizeof(g_range_lock_bits));
 	}
 
-	void save(utils::serial& ar)
+	void save(utils::serial& ar, bool incremental)
 	{
+		if (!incremental)
+		{
+			s_memory_mode = savestate_memory_mode::full;
+		}
+		else if (s_savestate_base.path.empty())
+		{
+			// A copy of this savestate is going to be the base
+			s_memory_mode = savestate_memory_mode::full_base;
+		}
+		else
+		{
+			// Store the difference from the base
+			s_memory_mode = savestate_memory_mode::incremental;
+		}
+
+		ar(static_cast<u8>(s_memory_mode));
+
 		// Shared memory lookup, sample address is saved for easy memory copy
 		// Just need one address for this optimization
 		std::vector<std::pair<utils::shm*, u32>> shared;
@@ -2332,13 +2548,13 @@ namespace vm
 		// TODO: proper serialization of std::map
 		ar(static_cast<usz>(shared_map.size()));
 
-		for (const auto& [shm, addr] : shared)
+		for (u32 index = 0; const auto& [shm, addr] : shared)
 		{
 			//  Save shared memory
 			ar(shm->flags());
 
 			ar(shm->size());
-			serialize_memory_bytes(ar, vm::get_super_ptr<u8>(addr), shm->size());
+			serialize_memory_region(ar, vm::get_super_ptr<u8>(addr), shm->size(), make_region_key(index++, true));
 		}
 
 		// TODO: Serialize std::vector direcly
@@ -2356,12 +2572,96 @@ namespace vm
 		}
 
 		is_memory_compatible_for_copy_from_executable_optimization(0, 0); // Cleanup internal data
+
+		if (s_memory_mode == savestate_memory_mode::incremental)
+		{
+			vm_log.success("Saved memory incrementally (base='%s')", s_savestate_base.path);
+		}
+
+		s_memory_mode = savestate_memory_mode::full;
+	}
+
+	std::string get_savestate_base()
+	{
+		if (!s_savestate_base.path.empty() && !fs::is_file(s_savestate_base.path))
+		{
+			vm_log.warning("The base of incremental savestates has been removed (path='%s')", s_savestate_base.path);
+			s_savestate_base = {};
+		}
+
+		return s_savestate_base.path;
 	}
 
-	void load(utils::serial& ar)
+	std::vector<std::tuple<u32, u8*, usz>> get_saved_memory_regions()
+	{
+		std::vector<std::pair<utils::shm*, u32>> shared;
+		std::vector<std::pair<u32, u32>> preallocated;
+
+		for (auto& loc : g_locations)
+		{
+			if (loc)
+			{
+				loc->get_shared_memory(shared);
+				loc->get_preallocated_memory(preallocated);
+			}
+		}
+
+		std::vector<std::tuple<u32, u8*, usz>> result;
+		std::set<utils::shm*> shared_set;
+
+		for (const auto& [shm, addr] : shared)
+		{
+			// First sample address, same as vm::save()
+			if (shared_set.emplace(shm).second)
+			{
+				result.emplace_back(addr, vm::get_super_ptr<u8>(addr), shm->size());
+			}
+		}
+
+		for (const auto& [addr, size] : preallocated)
+		{
+			result.emplace_back(addr, vm::get_super_ptr<u8>(addr), size);
+		}
+
+		return result;
+	}
+
+	void load(utils::serial& ar, const std::string& base_path)
 	{
 		std::vector<std::shared_ptr<utils::shm>> shared;
 
+		const u8 mode = GET_SERIALIZATION_VERSION(global_version) >= 20 ? ar.pop<u8>() : u8{0};
+
+		if (mode > static_cast<u8>(savestate_memory_mode::incremental))
+		{
+			fmt::throw_exception("Invalid VM serialization state: mode=%d, ar=%s", mode, ar);
+		}
+
+		s_memory_mode = static_cast<savestate_memory_mode>(mode);
+		s_savestate_base = {};
+		s_load_base.reset();
+
+		if (s_memory_mode == savestate_memory_mode::incremental)
+		{
+			// Unchanged pages are loaded from the base
+			s_load_base = base_path.empty() ? nullptr : make_savestate_reader(base_path);
+
+			if (!s_load_base)
+			{
+				fmt::throw_exception("Failed to open the base of incremental savestate (path='%s')", base_path);
+			}
+		}
+		else if (s_memory_mode == savestate_memory_mode::full_base && (base_path.empty() || !fs::is_file(base_path)))
+		{
+			vm_log.warning("The base of incremental savestates has been removed (path='%s')", base_path);
+			s_memory_mode = savestate_memory_mode::full;
+		}
+
+		if (s_memory_mode != savestate_memory_mode::full)
+		{
+			s_savestate_base.path = base_path;
+		}
+
 		const usz shared_size = ar.pop<usz>();
 
 		if (!shared_size || ar.get_size(umax) / 4096 < shared_size)
@@ -2371,7 +2671,7 @@ namespace vm
 
 		shared.resize(shared_size);
 
-		for (auto& shm : shared)
+		for (u32 index = 0; auto& shm : shared)
 		{
 			// Load shared memory
 
@@ -2381,7 +2681,7 @@ namespace vm
 
 			// Load binary image
 			// elad335: I'm not proud about it as well.. (ideal situation is to not call map_self())
-			serialize_memory_bytes(ar, shm->map_self(), shm->size());
+			serialize_memory_region(ar, shm->map_self(), shm->size(), make_region_key(index++, true));
 		}
 
 		for (auto& block : g_locations)
@@ -2401,6 +2701,14 @@ namespace vm
 				loc = std::make_shared<block_t>(ar, shared);
 			}
 		}
+
+		if (s_load_base)
+		{
+			vm_log.success("Loaded memory of incremental savestate (base='%s')", s_savestate_base.path);
+			s_load_base.reset();
+		}
+
+		s_memory_mode = savestate_memory_mode::full;
 	}
 
 	u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared)
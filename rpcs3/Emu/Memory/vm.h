@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <map>
+#include <tuple>
 #include "util/types.hpp"
 #include "util/atomic.hpp"
 #include "util/auto_typemap.hpp"
@@ -200,6 +201,9 @@ namespace vm
 		// Serialization helper for shared memory
 		void get_shared_memory(std::vector<std::pair<utils::shm*, u32>>& shared);
 
+		// Serialization helper for preallocated memory (address and size of each allocation, without stack guards)
+		void get_preallocated_memory(std::vector<std::pair<u32, u32>>& regions);
+
 		// Returns sample address for shared memory, 0 on failure
 		u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared);
 
@@ -369,8 +373,21 @@ namespace vm
 
 	void close();
 
-	void load(utils::serial& ar);
-	void save(utils::serial& ar);
+	// base_path: the base of an incremental savestate, or the copy of a full savestate made to be the base
+	void load(utils::serial& ar, const std::string& base_path = {});
+
+	// Incremental mode only stores memory pages which changed since the base savestate
+	// Without a base, the savestate is marked so that a copy of it can become the base
+	void save(utils::serial& ar, bool incremental = false);
+
+	// Base of incremental savestates (set by vm::load()), empty if a new base is needed
+	std::string get_savestate_base();
+
+	// Memory regions stored in savestates: address, pointer and size (memory must not be mapped or unmapped meanwhile)
+	std::vector<std::tuple<u32, u8*, usz>> get_saved_memory_regions();
+
+	// Hash of a 4096-byte page, used to find modified pages
+	u64 hash_memory_page(const u8* ptr);
 
 	// Returns sample address for shared memory, 0 on failure (wraps block_t::get_shm_addr)
 	u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared);
@@ -413,7 +413,7 @@ namespace
 	};
 
 	template <typename T>
-	NEVER_INLINE std::tuple<T, T, u32> upload_untouched_skip_restart(std::span<to_be_t<const T>> src, std::span<T> dst, T restart_index)
+	NEVER_INLINE std::tuple<T, T, u32> upload_untouched_skip_restart_naive(std::span<to_be_t<const T>> src, std::span<T> dst, T restart_index)
 	{
 		T min_index = index_limit<T>();
 		T max_index = 0;
@@ -432,142 +432,486 @@ namespace
 		return std::make_tuple(min_index, max_index, written);
 	}
 
-	template<typename T, typename U = remove_be_t<T>>
-		requires std::is_same_v<U, u32> || std::is_same_v<U, u16>
-	std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::span<T> dst, rsx::primitive_type draw_mode, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	// Quad expansion state, shared by the scalar and the vectorized loops
+	template <typename T>
+	struct quad_expander
 	{
-		if constexpr (std::is_same_v<T, u16>)
+		T* dst;
+		u32 dst_idx = 0;
+		T min_index = index_limit<T>();
+		T max_index = 0;
+		u8 set_size = 0;
+		T tmp_indices[4]{};
+
+		void push(T index)
 		{
-			if (primitive_restart_index > 0xffff)
+			tmp_indices[set_size++] = min_max(min_index, max_index, index);
+
+			if (set_size == 4)
 			{
-				// Will never trip index restart, unpload untouched
-				is_primitive_restart_enabled = false;
+				// First triangle
+				dst[dst_idx++] = tmp_indices[0];
+				dst[dst_idx++] = tmp_indices[1];
+				dst[dst_idx++] = tmp_indices[2];
+				// Second triangle
+				dst[dst_idx++] = tmp_indices[2];
+				dst[dst_idx++] = tmp_indices[3];
+				dst[dst_idx++] = tmp_indices[0];
+
+				set_size = 0;
 			}
 		}
+	};
 
-		if (!is_primitive_restart_enabled)
+	// Triangle fan expansion state, shared by the scalar and the vectorized loops
+	template <typename T>
+	struct fan_expander
+	{
+		static constexpr T invalid_index = index_limit<T>();
+
+		T* dst;
+		u32 dst_idx = 0;
+		T min_index = invalid_index;
+		T max_index = 0;
+		bool needs_anchor = true;
+		T anchor = invalid_index;
+		T last_index = invalid_index;
+
+		void restart()
 		{
-			return untouched_impl::upload_untouched(src, dst);
+			needs_anchor = true;
+			last_index = invalid_index;
 		}
 
-		if (is_primitive_disjointed(draw_mode))
+		void push(T index)
 		{
-			return upload_untouched_skip_restart(src, dst, static_cast<U>(primitive_restart_index));
+			if (needs_anchor)
+			{
+				anchor = min_max(min_index, max_index, index);
+				needs_anchor = false;
+				return;
+			}
+
+			if (last_index == invalid_index)
+			{
+				//Need at least one anchor and one outer index to create a triangle
+				last_index = min_max(min_index, max_index, index);
+				return;
+			}
+
+			dst[dst_idx++] = anchor;
+			dst[dst_idx++] = last_index;
+			dst[dst_idx++] = min_max(min_index, max_index, index);
+
+			last_index = index;
 		}
+	};
 
-		return primitive_restart_impl::upload_untouched(src, dst, static_cast<U>(primitive_restart_index));
+	template<typename T>
+	std::tuple<T, T, u32> expand_indexed_triangle_fan_naive(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	{
+		fan_expander<T> fan{dst.data()};
+
+		for (const T index : src)
+		{
+			if (is_primitive_restart_enabled && index == primitive_restart_index)
+			{
+				fan.restart();
+				continue;
+			}
+
+			fan.push(index);
+		}
+
+		return std::make_tuple(fan.min_index, fan.max_index, fan.dst_idx);
 	}
 
-	void iota16(u16* dst, u32 count)
+	template<typename T>
+	std::tuple<T, T, u32> expand_indexed_quads_naive(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
 	{
-		unsigned i = 0;
+		quad_expander<T> quads{dst.data()};
+
+		for (const T index : src)
+		{
+			if (is_primitive_restart_enabled && index == primitive_restart_index)
+			{
+				//empty temp buffer
+				quads.set_size = 0;
+				continue;
+			}
+
+			quads.push(index);
+		}
+
+		return std::make_tuple(quads.min_index, quads.max_index, quads.dst_idx);
+	}
+
 #if defined(ARCH_X64) || defined(ARCH_ARM64)
-		const unsigned step = 8;                          // We do 8 entries per step
-		const __m128i vec_step = _mm_set1_epi16(8);     // Constant to increment the raw values
-		__m128i values = _mm_set_epi16(7, 6, 5, 4, 3, 2, 1, 0);
-		__m128i* vec_ptr = utils::bless<__m128i>(dst);
+	// 128-bit helpers for the vectorized index routines below (NEON through sse2neon).
+	// Every routine handles whole vectors free of restart indices at once and hands the others to the scalar state.
+	template <typename T>
+	constexpr u32 index_lanes = 16 / sizeof(T);
 
-		for (; (i + step) <= count; i += step, vec_ptr++)
+	template <typename T>
+	SSE4_1_FUNC inline __m128i load_indices(const be_t<T>* src)
+	{
+		const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+		if constexpr (sizeof(T) == 2)
+			return _mm_shuffle_epi8(data, _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+		else
+			return _mm_shuffle_epi8(data, _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+	}
+
+	template <typename T>
+	SSE4_1_FUNC inline __m128i set1_index(T value)
+	{
+		if constexpr (sizeof(T) == 2)
+			return _mm_set1_epi16(static_cast<s16>(value));
+		else
+			return _mm_set1_epi32(static_cast<s32>(value));
+	}
+
+	template <typename T>
+	SSE4_1_FUNC inline bool any_index_eq(__m128i v, __m128i value)
+	{
+		const __m128i eq = sizeof(T) == 2 ? _mm_cmpeq_epi16(v, value) : _mm_cmpeq_epi32(v, value);
+		return !_mm_testz_si128(eq, eq);
+	}
+
+	template <typename T>
+	SSE4_1_FUNC inline void update_min_max(__m128i& vmin, __m128i& vmax, __m128i v)
+	{
+		if constexpr (sizeof(T) == 2)
 		{
-			_mm_stream_si128(vec_ptr, values);
-			_mm_add_epi16(values,  vec_step);
+			vmin = _mm_min_epu16(vmin, v);
+			vmax = _mm_max_epu16(vmax, v);
+		}
+		else
+		{
+			vmin = _mm_min_epu32(vmin, v);
+			vmax = _mm_max_epu32(vmax, v);
 		}
-#endif
-		for (; i < count; ++i)
-			dst[i] = i;
 	}
 
-	template<typename T>
-	std::tuple<T, T, u32> expand_indexed_triangle_fan(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	// Fold the vector accumulators into the scalar min/max
+	template <typename T>
+	SSE4_1_FUNC inline void reduce_min_max(__m128i vmin, __m128i vmax, T& min_index, T& max_index)
 	{
-		const T invalid_index = index_limit<T>();
+		T lanes_min[index_lanes<T>];
+		T lanes_max[index_lanes<T>];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_min), vmin);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes_max), vmax);
 
-		T min_index = invalid_index;
-		T max_index = 0;
+		for (u32 i = 0; i < index_lanes<T>; i++)
+		{
+			min_index = std::min(min_index, lanes_min[i]);
+			max_index = std::max(max_index, lanes_max[i]);
+		}
+	}
 
-		ensure((dst.size() >= 3 * (src.size() - 2)));
+	// Anchor lanes of the three output vectors of store_fan_triangles
+	template <typename T>
+	SSE4_1_FUNC inline void set_fan_anchor(__m128i (&lanes)[3], T anchor)
+	{
+		if constexpr (sizeof(T) == 2)
+		{
+			const s16 a = static_cast<s16>(anchor);
+			lanes[0] = _mm_setr_epi16(a, 0, 0, a, 0, 0, a, 0);
+			lanes[1] = _mm_setr_epi16(0, a, 0, 0, a, 0, 0, a);
+			lanes[2] = _mm_setr_epi16(0, 0, a, 0, 0, a, 0, 0);
+		}
+		else
+		{
+			const s32 a = static_cast<s32>(anchor);
+			lanes[0] = _mm_setr_epi32(a, 0, 0, a);
+			lanes[1] = _mm_setr_epi32(0, 0, a, 0);
+			lanes[2] = _mm_setr_epi32(0, a, 0, 0);
+		}
+	}
 
-		u32 dst_idx = 0;
+	// Emit the triangles (anchor, previous, current) for a vector of outer indices, returns the new previous index
+	template <typename T>
+	SSE4_1_FUNC inline T store_fan_triangles(T* dst, __m128i v, const __m128i (&anchor)[3], T last_index)
+	{
+		const auto out = reinterpret_cast<__m128i*>(dst);
 
-		bool needs_anchor = true;
-		T anchor = invalid_index;
-		T last_index = invalid_index;
+		// Zeroed lanes are filled with the anchor and the previous index
+		if constexpr (sizeof(T) == 2)
+		{
+			// (a, p, 0) (a, 0, 1) (a, 1, 2) (a, 2, 3) (a, 3, 4) (a, 4, 5) (a, 5, 6) (a, 6, 7)
+			_mm_storeu_si128(out + 0, _mm_or_si128(_mm_shuffle_epi8(v, _mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, 0, 1, 2, 3, -1, -1, 2, 3)), _mm_insert_epi16(anchor[0], last_index, 1)));
+			_mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(v, _mm_setr_epi8(4, 5, -1, -1, 4, 5, 6, 7, -1, -1, 6, 7, 8, 9, -1, -1)), anchor[1]));
+			_mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(v, _mm_setr_epi8(8, 9, 10, 11, -1, -1, 10, 11, 12, 13, -1, -1, 12, 13, 14, 15)), anchor[2]));
+			return static_cast<T>(_mm_extract_epi16(v, 7));
+		}
+		else
+		{
+			// (a, p, 0) (a, 0, 1) (a, 1, 2) (a, 2, 3)
+			_mm_storeu_si128(out + 0, _mm_or_si128(_mm_shuffle_epi8(v, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 2, 3, -1, -1, -1, -1)), _mm_insert_epi32(anchor[0], static_cast<s32>(last_index), 1)));
+			_mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(v, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, -1, -1, -1, 4, 5, 6, 7)), anchor[1]));
+			_mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(v, _mm_setr_epi8(8, 9, 10, 11, -1, -1, -1, -1, 8, 9, 10, 11, 12, 13, 14, 15)), anchor[2]));
+			return static_cast<T>(_mm_extract_epi32(v, 3));
+		}
+	}
 
-		for (const T index : src)
+	template <typename T>
+	SSE4_1_FUNC std::tuple<T, T, u32> upload_untouched_skip_restart_sse41(std::span<to_be_t<const T>> src, std::span<T> dst, T restart_index)
+	{
+		constexpr u32 lanes = index_lanes<T>;
+
+		const __m128i restart = set1_index<T>(restart_index);
+		__m128i vmin = _mm_set1_epi32(-1);
+		__m128i vmax = _mm_setzero_si128();
+
+		T min_index = index_limit<T>();
+		T max_index = 0;
+		u32 written = 0;
+		const u32 length = ::size32(src);
+		u32 i = 0;
+
+		for (; i + lanes <= length; i += lanes)
 		{
-			if (needs_anchor)
+			const __m128i v = load_indices<T>(src.data() + i);
+
+			if (any_index_eq<T>(v, restart))
 			{
-				if (is_primitive_restart_enabled && index == primitive_restart_index)
-					continue;
+				// Compact this vector
+				for (u32 j = i; j < i + lanes; j++)
+				{
+					const T index = src[j];
+
+					if (index != restart_index)
+					{
+						dst[written++] = min_max(min_index, max_index, index);
+					}
+				}
 
-				anchor = min_max(min_index, max_index, index);
-				needs_anchor = false;
 				continue;
 			}
 
-			if (is_primitive_restart_enabled && index == primitive_restart_index)
+			update_min_max<T>(vmin, vmax, v);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + written), v);
+			written += lanes;
+		}
+
+		for (; i < length; i++)
+		{
+			const T index = src[i];
+
+			if (index != restart_index)
 			{
-				needs_anchor = true;
-				last_index = invalid_index;
-				continue;
+				dst[written++] = min_max(min_index, max_index, index);
 			}
+		}
 
-			if (last_index == invalid_index)
+		reduce_min_max<T>(vmin, vmax, min_index, max_index);
+		return std::make_tuple(min_index, max_index, written);
+	}
+
+	template <typename T>
+	SSE4_1_FUNC std::tuple<T, T, u32> expand_indexed_triangle_fan_sse41(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	{
+		constexpr u32 lanes = index_lanes<T>;
+
+		// Vectors holding the sentinel value must go through the scalar state as well
+		const bool restart_in_range = is_primitive_restart_enabled && primitive_restart_index <= index_limit<T>();
+		const __m128i restart = set1_index<T>(static_cast<T>(primitive_restart_index));
+		const __m128i invalid = _mm_set1_epi32(-1);
+		__m128i vmin = _mm_set1_epi32(-1);
+		__m128i vmax = _mm_setzero_si128();
+
+		fan_expander<T> fan{dst.data()};
+		const u32 length = ::size32(src);
+		u32 i = 0;
+
+		T lanes_anchor = fan.anchor;
+		__m128i anchor_lanes[3];
+		set_fan_anchor<T>(anchor_lanes, lanes_anchor);
+
+		while (i < length)
+		{
+			if (i + lanes <= length && !fan.needs_anchor && fan.last_index != fan.invalid_index)
 			{
-				//Need at least one anchor and one outer index to create a triangle
-				last_index = min_max(min_index, max_index, index);
-				continue;
+				const __m128i v = load_indices<T>(src.data() + i);
+
+				if (!any_index_eq<T>(v, invalid) && !(restart_in_range && any_index_eq<T>(v, restart)))
+				{
+					if (fan.anchor != lanes_anchor)
+					{
+						lanes_anchor = fan.anchor;
+						set_fan_anchor<T>(anchor_lanes, lanes_anchor);
+					}
+
+					update_min_max<T>(vmin, vmax, v);
+					fan.last_index = store_fan_triangles<T>(dst.data() + fan.dst_idx, v, anchor_lanes, fan.last_index);
+					fan.dst_idx += lanes * 3;
+					i += lanes;
+					continue;
+				}
 			}
 
-			dst[dst_idx++] = anchor;
-			dst[dst_idx++] = last_index;
-			dst[dst_idx++] = min_max(min_index, max_index, index);
+			const T index = src[i++];
 
-			last_index = index;
+			if (is_primitive_restart_enabled && index == primitive_restart_index)
+			{
+				fan.restart();
+				continue;
+			}
+
+			fan.push(index);
 		}
 
-		return std::make_tuple(min_index, max_index, dst_idx);
+		reduce_min_max<T>(vmin, vmax, fan.min_index, fan.max_index);
+		return std::make_tuple(fan.min_index, fan.max_index, fan.dst_idx);
 	}
 
-	template<typename T>
-	std::tuple<T, T, u32> expand_indexed_quads(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	template <typename T>
+	SSE4_1_FUNC std::tuple<T, T, u32> expand_indexed_quads_sse41(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
 	{
-		T min_index = index_limit<T>();
-		T max_index = 0;
+		constexpr u32 lanes = index_lanes<T>;
 
-		ensure((4 * dst.size_bytes() >= 6 * src.size_bytes()));
+		const bool restart_in_range = is_primitive_restart_enabled && primitive_restart_index <= index_limit<T>();
+		const __m128i restart = set1_index<T>(static_cast<T>(primitive_restart_index));
+		__m128i vmin = _mm_set1_epi32(-1);
+		__m128i vmax = _mm_setzero_si128();
 
-		u32 dst_idx = 0;
-		u8 set_size = 0;
-		T tmp_indices[4];
+		quad_expander<T> quads{dst.data()};
+		const u32 length = ::size32(src);
+		u32 i = 0;
 
-		for (const T index : src)
+		while (i < length)
 		{
+			// Whole quads only, a vector holds two 16-bit quads or one 32-bit quad
+			if (quads.set_size == 0 && i + lanes <= length)
+			{
+				const __m128i v = load_indices<T>(src.data() + i);
+
+				if (!(restart_in_range && any_index_eq<T>(v, restart)))
+				{
+					update_min_max<T>(vmin, vmax, v);
+
+					auto out = reinterpret_cast<__m128i*>(dst.data() + quads.dst_idx);
+
+					if constexpr (sizeof(T) == 2)
+					{
+						// (0, 1, 2, 2, 3, 0) (4, 5, 6, 6, 7, 4)
+						_mm_storeu_si128(out, _mm_shuffle_epi8(v, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 4, 5, 6, 7, 0, 1, 8, 9, 10, 11)));
+						_mm_storel_epi64(out + 1, _mm_shuffle_epi8(v, _mm_setr_epi8(12, 13, 12, 13, 14, 15, 8, 9, -1, -1, -1, -1, -1, -1, -1, -1)));
+					}
+					else
+					{
+						// (0, 1, 2, 2, 3, 0)
+						_mm_storeu_si128(out, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 1, 0)));
+						_mm_storel_epi64(out + 1, _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 0, 0, 3)));
+					}
+
+					quads.dst_idx += lanes / 4 * 6;
+					i += lanes;
+					continue;
+				}
+			}
+
+			const T index = src[i++];
+
 			if (is_primitive_restart_enabled && index == primitive_restart_index)
 			{
 				//empty temp buffer
-				set_size = 0;
+				quads.set_size = 0;
 				continue;
 			}
 
-			tmp_indices[set_size++] = min_max(min_index, max_index, index);
+			quads.push(index);
+		}
 
-			if (set_size == 4)
-			{
-				// First triangle
-				dst[dst_idx++] = tmp_indices[0];
-				dst[dst_idx++] = tmp_indices[1];
-				dst[dst_idx++] = tmp_indices[2];
-				// Second triangle
-				dst[dst_idx++] = tmp_indices[2];
-				dst[dst_idx++] = tmp_indices[3];
-				dst[dst_idx++] = tmp_indices[0];
+		reduce_min_max<T>(vmin, vmax, quads.min_index, quads.max_index);
+		return std::make_tuple(quads.min_index, quads.max_index, quads.dst_idx);
+	}
+#endif
 
-				set_size = 0;
+	template <typename T>
+	std::tuple<T, T, u32> upload_untouched_skip_restart(std::span<to_be_t<const T>> src, std::span<T> dst, T restart_index)
+	{
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		if (s_use_sse4_1)
+		{
+			return upload_untouched_skip_restart_sse41<T>(src, dst, restart_index);
+		}
+#endif
+		return upload_untouched_skip_restart_naive<T>(src, dst, restart_index);
+	}
+
+	template<typename T, typename U = remove_be_t<T>>
+		requires std::is_same_v<U, u32> || std::is_same_v<U, u16>
+	std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::span<T> dst, rsx::primitive_type draw_mode, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	{
+		if constexpr (std::is_same_v<T, u16>)
+		{
+			if (primitive_restart_index > 0xffff)
+			{
+				// Will never trip index restart, unpload untouched
+				is_primitive_restart_enabled = false;
 			}
 		}
 
-		return std::make_tuple(min_index, max_index, dst_idx);
+		if (!is_primitive_restart_enabled)
+		{
+			return untouched_impl::upload_untouched(src, dst);
+		}
+
+		if (is_primitive_disjointed(draw_mode))
+		{
+			return upload_untouched_skip_restart(src, dst, static_cast<U>(primitive_restart_index));
+		}
+
+		return primitive_restart_impl::upload_untouched(src, dst, static_cast<U>(primitive_restart_index));
+	}
+
+	void iota16(u16* dst, u32 count)
+	{
+		unsigned i = 0;
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		const unsigned step = 8;                          // We do 8 entries per step
+		const __m128i vec_step = _mm_set1_epi16(8);     // Constant to increment the raw values
+		__m128i values = _mm_set_epi16(7, 6, 5, 4, 3, 2, 1, 0);
+		__m128i* vec_ptr = utils::bless<__m128i>(dst);
+
+		for (; (i + step) <= count; i += step, vec_ptr++)
+		{
+			_mm_stream_si128(vec_ptr, values);
+			values = _mm_add_epi16(values, vec_step);
+		}
+#endif
+		for (; i < count; ++i)
+			dst[i] = i;
+	}
+
+	template<typename T>
+	std::tuple<T, T, u32> expand_indexed_triangle_fan(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	{
+		ensure((dst.size() >= 3 * (src.size() - 2)));
+
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		if (s_use_sse4_1)
+		{
+			return expand_indexed_triangle_fan_sse41<T>(src, dst, is_primitive_restart_enabled, primitive_restart_index);
+		}
+#endif
+		return expand_indexed_triangle_fan_naive<T>(src, dst, is_primitive_restart_enabled, primitive_restart_index);
+	}
+
+	template<typename T>
+	std::tuple<T, T, u32> expand_indexed_quads(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
+	{
+		ensure((4 * dst.size_bytes() >= 6 * src.size_bytes()));
+
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		if (s_use_sse4_1)
+		{
+			return expand_indexed_quads_sse41<T>(src, dst, is_primitive_restart_enabled, primitive_restart_index);
+		}
+#endif
+		return expand_indexed_quads_naive<T>(src, dst, is_primitive_restart_enabled, primitive_restart_index);
 	}
 }
 
@@ -701,8 +1045,8 @@ namespace
 		case rsx::primitive_type::line_loop:
 		{
 			const auto &returnvalue = upload_untouched<T>(src, dst, draw_mode, restart_index_enabled, restart_index);
-			const auto index_count = dst.size_bytes() / sizeof(T);
-			dst[index_count] = src[0];
+			// Close the loop right after the uploaded indices (get_index_count reserves one extra index)
+			dst[src.size()] = src[0];
 			return returnvalue;
 		}
 		case rsx::primitive_type::polygon:
@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "Emu/Memory/vm.h"
 #include "TextureUtils.h"
+#include "texel_converters.h"
+#include "texture_decode_pool.h"
 #include "../RSXThread.h"
 #include "../rsx_utils.h"
 #include "3rdparty/bcdec/bcdec.hpp"
@@ -25,102 +27,68 @@ namespace utils
 namespace
 {
 
-#ifndef __APPLE__
-u16 convert_rgb655_to_rgb565(const u16 bits)
-{
-	// g6 = g5
-	// r5 = (((bits & 0xFC00) >> 1) & 0xFC00) << 1 is equivalent to truncating the least significant bit
-	return (bits & 0xF81F) | (bits & 0x3E0) << 1;
-}
-#else
-u32 convert_rgb565_to_bgra8(const u16 bits)
-{
-	const u8 r5 = ((bits >> 11) & 0x1F);
-	const u8 g6 = ((bits >> 5) & 0x3F);
-	const u8 b5 = (bits & 0x1F);
-
-	const u8 b8 = ((b5 * 527) + 23) >> 6;
-	const u8 g8 = ((g6 * 259) + 33) >> 6;
-	const u8 r8 = ((r5 * 527) + 23) >> 6;
-	const u8 a8 = 255;
-
-	return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
-}
-
-u32 convert_argb4_to_bgra8(const u16 bits)
-{
-	const u8 b8 = (bits & 0xF0);
-	const u8 g8 = ((bits >> 4) & 0xF0);
-	const u8 r8 = ((bits >> 8) & 0xF0);
-	const u8 a8 = ((bits << 4) & 0xF0);
-
-	return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
-}
-
-u32 convert_a1rgb5_to_bgra8(const u16 bits)
-{
-	const u8 a1 = ((bits >> 11) & 0x80);
-	const u8 r5 = ((bits >> 10) & 0x1F);
-	const u8 g5 = ((bits >> 5) & 0x1F);
-	const u8 b5 = (bits & 0x1F);
-
-	const u8 b8 = ((b5 * 527) + 23) >> 6;
-	const u8 g8 = ((g5 * 527) + 23) >> 6;
-	const u8 r8 = ((r5 * 527) + 23) >> 6;
-	const u8 a8 = a1;
-
-	return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
-}
-
-u32 convert_rgb5a1_to_bgra8(const u16 bits)
-{
-	const u8 r5 = ((bits >> 11) & 0x1F);
-	const u8 g5 = ((bits >> 6) & 0x1F);
-	const u8 b5 = ((bits >> 1) & 0x1F);
-	const u8 a1 = (bits & 0x80);
-
-	const u8 b8 = ((b5 * 527) + 23) >> 6;
-	const u8 g8 = ((g5 * 527) + 23) >> 6;
-	const u8 r8 = ((r5 * 527) + 23) >> 6;
-	const u8 a8 = a1;
-
-	return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
-}
-
-u32 convert_rgb655_to_bgra8(const u16 bits)
+/**
+ * Decode a level in bands of block rows on the texture decode workers, or inline when it is small.
+ * Bands are only formed for borderless layouts where all block rows of all layers are equally spaced.
+ * func receives (dst, src, row_count, depth) of the band.
+ */
+template <typename T, typename U, typename F>
+void decode_level(std::span<T> dst, std::span<const U> src, u16 row_count, u16 depth, u8 border, u32 dst_row_stride, u32 src_row_stride, F&& func)
 {
-	const u8 r6 = ((bits >> 10) & 0x3F);
-	const u8 g5 = ((bits >> 5) & 0x1F);
-	const u8 b5 = ((bits) & 0x1F);
+	if (!border)
+	{
+		const auto decode_band = [&](u32 first, u32 count)
+		{
+			func(dst.subspan(usz{first} * dst_row_stride), src.subspan(usz{first} * src_row_stride), static_cast<u16>(count), u16{1});
+		};
 
-	const u8 b8 = ((b5 * 527) + 23) >> 6;
-	const u8 g8 = ((g5 * 527) + 23) >> 6;
-	const u8 r8 = ((r6 * 259) + 33) >> 6;
-	const u8 a8 = 1;
+		if (auto pool = g_fxo->try_get<rsx::texture_decode_pool>(); pool && pool->try_run(u32{row_count} * depth, dst_row_stride * sizeof(T), decode_band))
+		{
+			return;
+		}
+	}
 
-	return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	func(dst, src, row_count, depth);
 }
 
-u32 convert_d1rgb5_to_bgra8(const u16 bits)
+// 3D deswizzle, split by output slices on the texture decode workers
+template <typename T>
+void deswizzle_level(const void* src, void* dst, u16 width, u16 height, u16 depth)
 {
-	const u8 r5 = ((bits >> 10) & 0x1F);
-	const u8 g5 = ((bits >> 5) & 0x1F);
-	const u8 b5 = (bits & 0x1F);
+	if (depth > 1)
+	{
+		const auto decode_slices = [&](u32 first, u32 count)
+		{
+			rsx::convert_linear_swizzle_3d<T>(src, dst, width, height, depth, static_cast<u16>(first), static_cast<u16>(count));
+		};
 
-	const u8 b8 = ((b5 * 527) + 23) >> 6;
-	const u8 g8 = ((g5 * 527) + 23) >> 6;
-	const u8 r8 = ((r5 * 527) + 23) >> 6;
-	const u8 a8 = 1;
+		if (auto pool = g_fxo->try_get<rsx::texture_decode_pool>(); pool && pool->try_run(depth, usz{width} * height * sizeof(T), decode_slices))
+		{
+			return;
+		}
+	}
 
-	return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	rsx::convert_linear_swizzle_3d<T>(src, dst, width, height, depth);
 }
 
+#ifdef __APPLE__
 struct convert_16_block_32
 {
 	template<typename T>
-	static void copy_mipmap_level(std::span<u32> dst, std::span<const T> src, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 src_pitch_in_block, u32 (*converter)(const u16))
+	static void copy_mipmap_level(std::span<u32> dst, std::span<const T> src, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 src_pitch_in_block, rsx::texel_conversion conversion)
+	{
+		decode_level(dst, src, row_count, depth, border, dst_pitch_in_block, src_pitch_in_block, [&](std::span<u32> band_dst, std::span<const T> band_src, u16 rows, u16 layers)
+		{
+			copy_rows(band_dst, band_src, width_in_block, rows, layers, border, dst_pitch_in_block, src_pitch_in_block, conversion);
+		});
+	}
+
+	template<typename T>
+	static void copy_rows(std::span<u32> dst, std::span<const T> src, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 src_pitch_in_block, rsx::texel_conversion conversion)
 	{
-		static_assert(sizeof(T) == 2, "Type size doesn't match.");
+		static_assert(std::is_same_v<T, be_t<u16>>, "Type doesn't match.");
+
+		const auto convert_row = rsx::get_texel_row_converter(conversion);
 
 		u32 src_offset = 0, dst_offset = 0;
 		const u32 v_porch = src_pitch_in_block * border;
@@ -132,10 +100,7 @@ struct convert_16_block_32
 
 			for (u32 row = 0; row < row_count; ++row)
 			{
-				for (int col = 0; col < width_in_block; ++col)
-				{
-					dst[dst_offset + col] = converter(src[src_offset + col + border]);
-				}
+				convert_row(dst.data() + dst_offset, src.data() + src_offset + border, width_in_block);
 
 				src_offset += src_pitch_in_block;
 				dst_offset += dst_pitch_in_block;
@@ -150,7 +115,7 @@ struct convert_16_block_32
 struct convert_16_block_32_swizzled
 {
 	template<typename T, typename U>
-	static void copy_mipmap_level(std::span<T> dst, std::span<const U> src, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 (*converter)(const u16))
+	static void copy_mipmap_level(std::span<T> dst, std::span<const U> src, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, rsx::texel_conversion conversion)
 	{
 		u32 padded_width, padded_height;
 		if (border)
@@ -167,10 +132,10 @@ struct convert_16_block_32_swizzled
 		u32 size = padded_width * padded_height * depth * 2;
 		rsx::simple_array<U> tmp(size);
 
-		rsx::convert_linear_swizzle_3d<U>(src.data(), tmp.data(), padded_width, padded_height, depth);
+		deswizzle_level<U>(src.data(), tmp.data(), padded_width, padded_height, depth);
 
 		std::span<const U> src_span = tmp;
-		convert_16_block_32::copy_mipmap_level(dst, src_span, width_in_block, row_count, depth, border, dst_pitch_in_block, padded_width, converter);
+		convert_16_block_32::copy_mipmap_level(dst, src_span, width_in_block, row_count, depth, border, dst_pitch_in_block, padded_width, conversion);
 	}
 };
 #endif
@@ -179,6 +144,15 @@ struct copy_unmodified_block
 {
 	template<typename T, typename U>
 	static void copy_mipmap_level(std::span<T> dst, std::span<const U> src, u16 words_per_block, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 src_pitch_in_block)
+	{
+		decode_level(dst, src, row_count, depth, border, dst_pitch_in_block * words_per_block, src_pitch_in_block * words_per_block, [&](std::span<T> band_dst, std::span<const U> band_src, u16 rows, u16 layers)
+		{
+			copy_rows(band_dst, band_src, words_per_block, width_in_block, rows, layers, border, dst_pitch_in_block, src_pitch_in_block);
+		});
+	}
+
+	template<typename T, typename U>
+	static void copy_rows(std::span<T> dst, std::span<const U> src, u16 words_per_block, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
 		static_assert(sizeof(T) == sizeof(U), "Type size doesn't match.");
 
@@ -227,7 +201,7 @@ struct copy_unmodified_block_swizzled
 	{
 		if (std::is_same_v<T, U> && dst_pitch_in_block == width_in_block && words_per_block == 1 && !border)
 		{
-			rsx::convert_linear_swizzle_3d<T>(src.data(), dst.data(), width_in_block, row_count, depth);
+			deswizzle_level<T>(src.data(), dst.data(), width_in_block, row_count, depth);
 		}
 		else
 		{
@@ -248,20 +222,20 @@ struct copy_unmodified_block_swizzled
 
 			if (words_per_block == 1) [[likely]]
 			{
-				rsx::convert_linear_swizzle_3d<T>(src.data(), tmp.data(), padded_width, padded_height, depth);
+				deswizzle_level<T>(src.data(), tmp.data(), padded_width, padded_height, depth);
 			}
 			else
 			{
 				switch (words_per_block * sizeof(T))
 				{
 				case 4:
-					rsx::convert_linear_swizzle_3d<u32>(src.data(), tmp.data(), padded_width, padded_height, depth);
+					deswizzle_level<u32>(src.data(), tmp.data(), padded_width, padded_height, depth);
 					break;
 				case 8:
-					rsx::convert_linear_swizzle_3d<u64>(src.data(), tmp.data(), padded_width, padded_height, depth);
+					deswizzle_level<u64>(src.data(), tmp.data(), padded_width, padded_height, depth);
 					break;
 				case 16:
-					rsx::convert_linear_swizzle_3d<u128>(src.data(), tmp.data(), padded_width, padded_height, depth);
+					deswizzle_level<u128>(src.data(), tmp.data(), padded_width, padded_height, depth);
 					break;
 				default:
 					fmt::throw_exception("Failed to decode swizzled format, words_per_block=%d, src_type_size=%d", words_per_block, sizeof(T));
@@ -397,41 +371,26 @@ struct copy_decoded_rb_rg_block
 	template <bool SwapWords = false, typename T>
 	static void copy_mipmap_level(std::span<u32> dst, std::span<const T> src, u16 width_in_block, u16 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
-		static_assert(sizeof(T) == 4, "Type size doesn't match.");
+		decode_level(dst, src, row_count, depth, 0, dst_pitch_in_block, src_pitch_in_block, [&](std::span<u32> band_dst, std::span<const T> band_src, u16 rows, u16 layers)
+		{
+			copy_rows<SwapWords>(band_dst, band_src, width_in_block, rows, layers, dst_pitch_in_block, src_pitch_in_block);
+		});
+	}
+
+	template <bool SwapWords = false, typename T>
+	static void copy_rows(std::span<u32> dst, std::span<const T> src, u16 width_in_block, u16 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
+	{
+		static_assert(std::is_same_v<T, u32>, "Type doesn't match.");
+
+		// Decompress one block to 2 pixels at a time and write output in BGRA format
+		const auto convert_row = rsx::get_rb_rg_row_converter(SwapWords);
 
 		u32 src_offset = 0;
 		u32 dst_offset = 0;
 
-		// Temporaries
-		u32 red0, red1, blue, green;
-
 		for (int row = 0; row < row_count * depth; ++row)
 		{
-			for (int col = 0; col < width_in_block; ++col)
-			{
-				// Decompress one block to 2 pixels at a time and write output in BGRA format
-				const auto data = src[src_offset + col];
-
-				if constexpr (SwapWords)
-				{
-					// BR_GR
-					blue = (data >> 0) & 0xFF;
-					red0 = (data >> 8) & 0xFF;
-					green = (data >> 16) & 0XFF;
-					red1 = (data >> 24) & 0xFF;
-				}
-				else
-				{
-					// RB_RG
-					red0 = (data >> 0) & 0xFF;
-					blue = (data >> 8) & 0xFF;
-					red1 = (data >> 16) & 0XFF;
-					green = (data >> 24) & 0xFF;
-				}
-
-				dst[dst_offset + (col * 2)] = blue | (green << 8) | (red0 << 16) | (0xFF << 24);
-				dst[dst_offset + (col * 2 + 1)] = blue | (green << 8) | (red1 << 16) | (0xFF << 24);
-			}
+			convert_row(dst.data() + dst_offset, src.data() + src_offset, width_in_block);
 
 			src_offset += src_pitch_in_block;
 			dst_offset += dst_pitch_in_block;
@@ -444,7 +403,18 @@ struct copy_rgb655_block
 	template<typename T>
 	static void copy_mipmap_level(std::span<u16> dst, std::span<const T> src, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
-		static_assert(sizeof(T) == 2, "Type size doesn't match.");
+		decode_level(dst, src, row_count, depth, border, dst_pitch_in_block, src_pitch_in_block, [&](std::span<u16> band_dst, std::span<const T> band_src, u16 rows, u16 layers)
+		{
+			copy_rows(band_dst, band_src, width_in_block, rows, layers, border, dst_pitch_in_block, src_pitch_in_block);
+		});
+	}
+
+	template<typename T>
+	static void copy_rows(std::span<u16> dst, std::span<const T> src, u16 width_in_block, u16 row_count, u16 depth, u8 border, u32 dst_pitch_in_block, u32 src_pitch_in_block)
+	{
+		static_assert(std::is_same_v<T, be_t<u16>>, "Type doesn't match.");
+
+		const auto convert_row = rsx::get_rgb655_to_rgb565_row_converter();
 
 		u32 src_offset = 0, dst_offset = 0;
 		const u32 v_porch = src_pitch_in_block * border;
@@ -456,10 +426,7 @@ struct copy_rgb655_block
 
 			for (u32 row = 0; row < row_count; ++row)
 			{
-				for (int col = 0; col < width_in_block; ++col)
-				{
-					dst[dst_offset + col] = convert_rgb655_to_rgb565(src[src_offset + col + border]);
-				}
+				convert_row(dst.data() + dst_offset, src.data() + src_offset + border, width_in_block);
 
 				src_offset += src_pitch_in_block;
 				dst_offset += dst_pitch_in_block;
@@ -491,7 +458,7 @@ struct copy_rgb655_block_swizzled
 		u32 size = padded_width * padded_height * depth * 2;
 		rsx::simple_array<U> tmp(size);
 
-		rsx::convert_linear_swizzle_3d<U>(src.data(), tmp.data(), padded_width, padded_height, depth);
+		deswizzle_level<U>(src.data(), tmp.data(), padded_width, padded_height, depth);
 
 		std::span<const U> src_span = tmp;
 		copy_rgb655_block::copy_mipmap_level(dst, src_span, width_in_block, row_count, depth, border, dst_pitch_in_block, padded_width);
@@ -501,6 +468,15 @@ struct copy_rgb655_block_swizzled
 struct copy_decoded_bc1_block
 {
 	static void copy_mipmap_level(std::span<u32> dst, std::span<const u64> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
+	{
+		// Each block row decodes to 4 rows of texels
+		decode_level(dst, src, static_cast<u16>(row_count), depth, 0, dst_pitch_in_block * 4, src_pitch_in_block, [&](std::span<u32> band_dst, std::span<const u64> band_src, u16 rows, u16 layers)
+		{
+			copy_rows(band_dst, band_src, width_in_block, rows, layers, dst_pitch_in_block, src_pitch_in_block);
+		});
+	}
+
+	static void copy_rows(std::span<u32> dst, std::span<const u64> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
 		u32 src_offset = 0, dst_offset = 0, destinationPitch = dst_pitch_in_block * 4;
 		for (u32 row = 0; row < row_count * depth; row++)
@@ -521,6 +497,15 @@ struct copy_decoded_bc1_block
 struct copy_decoded_bc2_block
 {
 	static void copy_mipmap_level(std::span<u32> dst, std::span<const u128> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
+	{
+		// Each block row decodes to 4 rows of texels
+		decode_level(dst, src, static_cast<u16>(row_count), depth, 0, dst_pitch_in_block * 4, src_pitch_in_block, [&](std::span<u32> band_dst, std::span<const u128> band_src, u16 rows, u16 layers)
+		{
+			copy_rows(band_dst, band_src, width_in_block, rows, layers, dst_pitch_in_block, src_pitch_in_block);
+		});
+	}
+
+	static void copy_rows(std::span<u32> dst, std::span<const u128> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
 		u32 src_offset = 0, dst_offset = 0, destinationPitch = dst_pitch_in_block * 4;
 		for (u32 row = 0; row < row_count * depth; row++)
@@ -541,6 +526,15 @@ struct copy_decoded_bc2_block
 struct copy_decoded_bc3_block
 {
 	static void copy_mipmap_level(std::span<u32> dst, std::span<const u128> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
+	{
+		// Each block row decodes to 4 rows of texels
+		decode_level(dst, src, static_cast<u16>(row_count), depth, 0, dst_pitch_in_block * 4, src_pitch_in_block, [&](std::span<u32> band_dst, std::span<const u128> band_src, u16 rows, u16 layers)
+		{
+			copy_rows(band_dst, band_src, width_in_block, rows, layers, dst_pitch_in_block, src_pitch_in_block);
+		});
+	}
+
+	static void copy_rows(std::span<u32> dst, std::span<const u128> src, u16 width_in_block, u32 row_count, u16 depth, u32 dst_pitch_in_block, u32 src_pitch_in_block)
 	{
 		u32 src_offset = 0, dst_offset = 0, destinationPitch = dst_pitch_in_block * 4;
 		for (u32 row = 0; row < row_count * depth; row++)
@@ -916,49 +910,49 @@ namespace rsx
 		case CELL_GCM_TEXTURE_R6G5B5:
 		{
 			if (is_swizzled)
-				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), &convert_rgb655_to_bgra8);
+				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), rsx::texel_conversion::rgb655_to_bgra8);
 			else
-				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, &convert_rgb655_to_bgra8);
+				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, rsx::texel_conversion::rgb655_to_bgra8);
 			break;
 		}
 		case CELL_GCM_TEXTURE_D1R5G5B5:
 		{
 			if (is_swizzled)
-				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), &convert_d1rgb5_to_bgra8);
+				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), rsx::texel_conversion::d1rgb5_to_bgra8);
 			else
-				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, &convert_d1rgb5_to_bgra8);
+				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, rsx::texel_conversion::d1rgb5_to_bgra8);
 			break;
 		}
 		case CELL_GCM_TEXTURE_A1R5G5B5:
 		{
 			if (is_swizzled)
-				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), &convert_a1rgb5_to_bgra8);
+				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), rsx::texel_conversion::a1rgb5_to_bgra8);
 			else
-				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, &convert_a1rgb5_to_bgra8);
+				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, rsx::texel_conversion::a1rgb5_to_bgra8);
 			break;
 		}
 		case CELL_GCM_TEXTURE_A4R4G4B4:
 		{
 			if (is_swizzled)
-				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), &convert_argb4_to_bgra8);
+				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), rsx::texel_conversion::argb4_to_bgra8);
 			else
-				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, &convert_argb4_to_bgra8);
+				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, rsx::texel_conversion::argb4_to_bgra8);
 			break;
 		}
 		case CELL_GCM_TEXTURE_R5G5B5A1:
 		{
 			if (is_swizzled)
-				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), &convert_rgb5a1_to_bgra8);
+				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), rsx::texel_conversion::rgb5a1_to_bgra8);
 			else
-				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, &convert_rgb5a1_to_bgra8);
+				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, rsx::texel_conversion::rgb5a1_to_bgra8);
 			break;
 		}
 		case CELL_GCM_TEXTURE_R5G6B5:
 		{
 			if (is_swizzled)
-				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), &convert_rgb565_to_bgra8);
+				convert_16_block_32_swizzled::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), rsx::texel_conversion::rgb565_to_bgra8);
 			else
-				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, &convert_rgb565_to_bgra8);
+				convert_16_block_32::copy_mipmap_level(dst_buffer.as_span<u32>(), src_layout.data.as_span<const be_t<u16>>(), w, h, depth, src_layout.border, get_row_pitch_in_block<u32>(w, caps.alignment), src_layout.pitch_in_block, rsx::texel_conversion::rgb565_to_bgra8);
 			break;
 		}
 #endif
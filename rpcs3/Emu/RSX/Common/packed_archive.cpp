@@ -0,0 +1,475 @@
+#include "stdafx.h"
+#include "packed_archive.h"
+
+#include <zlib.h>
+#include <zstd.h>
+
+namespace rsx
+{
+	struct packed_archive_header
+	{
+		le_t<u64> magic;
+		le_t<u32> version;
+		le_t<u32> reserved;
+	};
+
+	// Followed by the key and the (possibly compressed) data
+	struct packed_archive_record
+	{
+		le_t<u32> magic;
+		le_t<u16> key_size;
+		le_t<u16> flags;
+		le_t<u32> data_size; // Stored size
+		le_t<u32> raw_size;  // Uncompressed size
+		le_t<u32> crc;       // CRC32 of the key and the stored data
+	};
+
+	static constexpr u64 c_archive_magic = "RSXPACK"_u64;
+	static constexpr u32 c_archive_version = 1;
+	static constexpr u32 c_record_magic = "PREC"_u32;
+	static constexpr u16 c_record_zstd = 1;
+	static constexpr int c_zstd_level = 3;
+
+	static u32 record_crc(std::span<const u8> key, std::span<const u8> data)
+	{
+		uLong crc = ::crc32(0, reinterpret_cast<const Bytef*>(key.data()), static_cast<uInt>(key.size()));
+		crc = ::crc32(crc, reinterpret_cast<const Bytef*>(data.data()), static_cast<uInt>(data.size()));
+		return static_cast<u32>(crc);
+	}
+
+	// Validate record at pos, returns its total size or 0 if the rest of the buffer is unusable
+	static u64 parse_record(std::span<const u8> buf, u64 pos, packed_archive_record& rec, bool& valid)
+	{
+		valid = false;
+
+		if (buf.size() < sizeof(rec) || pos > buf.size() - sizeof(rec))
+		{
+			return 0;
+		}
+
+		std::memcpy(&rec, buf.data() + pos, sizeof(rec));
+
+		const u64 total = sizeof(rec) + u64{rec.key_size} + rec.data_size;
+
+		if (rec.magic != c_record_magic || total > buf.size() - pos)
+		{
+			return 0;
+		}
+
+		const std::span<const u8> key = buf.subspan(pos + sizeof(rec), rec.key_size);
+		const std::span<const u8> data = buf.subspan(pos + sizeof(rec) + rec.key_size, rec.data_size);
+
+		valid = record_crc(key, data) == rec.crc && (rec.flags & c_record_zstd || rec.raw_size == rec.data_size);
+		return total;
+	}
+
+	static bool unpack_record(const packed_archive_record& rec, std::span<const u8> data, std::vector<u8>& out)
+	{
+		if (!(rec.flags & c_record_zstd))
+		{
+			out.assign(data.begin(), data.end());
+			return true;
+		}
+
+		out.resize(rec.raw_size);
+
+		const usz res = ::ZSTD_decompress(out.data(), out.size(), data.data(), data.size());
+
+		if (ZSTD_isError(res) || res != out.size())
+		{
+			rsx_log.error("packed_archive: Failed to decompress record (%s)", ZSTD_isError(res) ? ZSTD_getErrorName(res) : "size mismatch");
+			return false;
+		}
+
+		return true;
+	}
+
+	static bool read_all(const fs::file& file, std::vector<u8>& buf)
+	{
+		// One sequential read
+		buf.resize(file.size());
+		return file.read_at(0, buf.data(), buf.size()) == buf.size();
+	}
+
+	bool packed_archive::open(const std::string& path, bool compress)
+	{
+		std::lock_guard lock(m_mutex);
+
+		m_index.clear();
+		m_end = sizeof(packed_archive_header);
+		m_dead_bytes = 0;
+		m_path = path;
+		m_compress = compress;
+
+		if (!m_file.open(path, fs::read + fs::write + fs::create + fs::append))
+		{
+			rsx_log.error("packed_archive: Failed to open '%s' (%s)", path, fs::g_tls_error);
+			return false;
+		}
+
+		std::vector<u8> buf;
+
+		if (!read_all(m_file, buf))
+		{
+			rsx_log.error("packed_archive: Failed to read '%s' (%s)", path, fs::g_tls_error);
+			m_file.close();
+			return false;
+		}
+
+		packed_archive_header header{};
+
+		if (buf.size() >= sizeof(header))
+		{
+			std::memcpy(&header, buf.data(), sizeof(header));
+		}
+
+		if (header.magic != c_archive_magic || header.version != c_archive_version)
+		{
+			if (!buf.empty())
+			{
+				rsx_log.error("packed_archive: Discarding incompatible archive '%s'", path);
+			}
+
+			header = {c_archive_magic, c_archive_version, 0};
+
+			if (!m_file.trunc(0) || m_file.write(&header, sizeof(header)) != sizeof(header))
+			{
+				m_file.close();
+				return false;
+			}
+
+			return true;
+		}
+
+		u64 pos = sizeof(header);
+
+		for (packed_archive_record rec{}; pos < buf.size();)
+		{
+			bool valid = false;
+			const u64 total = parse_record(buf, pos, rec, valid);
+
+			if (!total)
+			{
+				break;
+			}
+
+			const std::string_view key(reinterpret_cast<const char*>(buf.data() + pos + sizeof(rec)), rec.key_size);
+
+			if (!valid || !m_index.try_emplace(std::string(key), record_info{pos, static_cast<u32>(total)}).second)
+			{
+				m_dead_bytes += total;
+			}
+
+			pos += total;
+		}
+
+		m_end = pos;
+
+		if (pos < buf.size())
+		{
+			rsx_log.warning("packed_archive: Discarding %u bytes of truncated data in '%s'", buf.size() - pos, path);
+
+			if (!m_file.trunc(pos))
+			{
+				m_file.close();
+				return false;
+			}
+		}
+
+		if (m_dead_bytes && m_dead_bytes >= m_end / 4 && !compact_unlocked())
+		{
+			rsx_log.error("packed_archive: Failed to compact '%s'", path);
+		}
+
+		return m_file.operator bool();
+	}
+
+	void packed_archive::close()
+	{
+		std::lock_guard lock(m_mutex);
+
+		m_file.close();
+		m_index.clear();
+	}
+
+	usz packed_archive::size() const
+	{
+		reader_lock lock(m_mutex);
+		return m_index.size();
+	}
+
+	bool packed_archive::contains(std::string_view key) const
+	{
+		reader_lock lock(m_mutex);
+		return m_index.contains(std::string(key));
+	}
+
+	bool packed_archive::read(std::string_view key, std::vector<u8>& out) const
+	{
+		reader_lock lock(m_mutex);
+
+		const auto found = m_index.find(std::string(key));
+
+		if (!m_file || found == m_index.end())
+		{
+			return false;
+		}
+
+		std::vector<u8> buf(found->second.size);
+
+		if (m_file.read_at(found->second.offset, buf.data(), buf.size()) != buf.size())
+		{
+			return false;
+		}
+
+		packed_archive_record rec{};
+		bool valid = false;
+
+		if (!parse_record(buf, 0, rec, valid) || !valid)
+		{
+			rsx_log.error("packed_archive: Corrupted record '%s' in '%s'", key, m_path);
+			return false;
+		}
+
+		return unpack_record(rec, std::span<const u8>(buf).subspan(sizeof(rec) + rec.key_size, rec.data_size), out);
+	}
+
+	usz packed_archive::for_each(const record_func& func) const
+	{
+		reader_lock lock(m_mutex);
+
+		std::vector<u8> buf;
+
+		if (!m_file || !read_all(m_file, buf))
+		{
+			return 0;
+		}
+
+		std::vector<u8> data;
+		usz count = 0;
+
+		for (u64 pos = sizeof(packed_archive_header); pos < std::min<u64>(m_end, buf.size());)
+		{
+			packed_archive_record rec{};
+			bool valid = false;
+			const u64 total = parse_record(buf, pos, rec, valid);
+
+			if (!total)
+			{
+				break;
+			}
+
+			const std::string_view key(reinterpret_cast<const char*>(buf.data() + pos + sizeof(rec)), rec.key_size);
+
+			// Skip dead records
+			if (const auto found = m_index.find(std::string(key)); valid && found != m_index.end() && found->second.offset == pos)
+			{
+				if (unpack_record(rec, std::span<const u8>(buf).subspan(pos + sizeof(rec) + rec.key_size, rec.data_size), data))
+				{
+					func(key, data);
+					count++;
+				}
+			}
+
+			pos += total;
+		}
+
+		return count;
+	}
+
+	bool packed_archive::add(std::string_view key, std::span<const u8> data)
+	{
+		if (key.size() > u16{umax} || data.size() > u32{umax})
+		{
+			return false;
+		}
+
+		std::vector<u8> compressed;
+		std::span<const u8> stored = data;
+		u16 flags = 0;
+
+		if (m_compress && data.size() >= 64)
+		{
+			compressed.resize(::ZSTD_compressBound(data.size()));
+
+			const usz res = ::ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), c_zstd_level);
+
+			if (!ZSTD_isError(res) && res < data.size())
+			{
+				stored = {compressed.data(), res};
+				flags |= c_record_zstd;
+			}
+		}
+
+		const std::span<const u8> key_bytes(reinterpret_cast<const u8*>(key.data()), key.size());
+
+		const packed_archive_record rec
+		{
+			c_record_magic,
+			static_cast<u16>(key.size()),
+			flags,
+			static_cast<u32>(stored.size()),
+			static_cast<u32>(data.size()),
+			record_crc(key_bytes, stored)
+		};
+
+		const fs::iovec_clone gather[3]
+		{
+			{&rec, sizeof(rec)},
+			{key_bytes.data(), key_bytes.size()},
+			{stored.data(), stored.size()}
+		};
+
+		const u64 total = sizeof(rec) + key_bytes.size() + stored.size();
+
+		std::lock_guard lock(m_mutex);
+
+		if (!m_file || m_index.contains(std::string(key)))
+		{
+			return false;
+		}
+
+		if (const u64 written = m_file.write_gather(gather, 3); written != total)
+		{
+			rsx_log.error("packed_archive: Failed to append to '%s' (written=0x%x, %s)", m_path, written, fs::g_tls_error);
+			m_end += written;
+			m_dead_bytes += written;
+			return false;
+		}
+
+		m_index.emplace(std::string(key), record_info{m_end, static_cast<u32>(total)});
+		m_end += total;
+		return true;
+	}
+
+	bool packed_archive::compact()
+	{
+		std::lock_guard lock(m_mutex);
+		return compact_unlocked();
+	}
+
+	bool packed_archive::compact_unlocked()
+	{
+		if (!m_file)
+		{
+			return false;
+		}
+
+		std::vector<u8> buf;
+
+		if (!read_all(m_file, buf))
+		{
+			return false;
+		}
+
+		std::vector<std::pair<const std::string*, record_info>> records;
+		records.reserve(m_index.size());
+
+		for (const auto& [key, info] : m_index)
+		{
+			if (info.offset + info.size > buf.size())
+			{
+				return false;
+			}
+
+			records.emplace_back(&key, info);
+		}
+
+		std::sort(records.begin(), records.end(), FN(x.second.offset < y.second.offset));
+
+		fs::pending_file temp(m_path);
+
+		const packed_archive_header header{c_archive_magic, c_archive_version, 0};
+
+		if (!temp.file || temp.file.write(&header, sizeof(header)) != sizeof(header))
+		{
+			return false;
+		}
+
+		std::vector<record_info> new_offsets;
+		new_offsets.reserve(records.size());
+
+		u64 pos = sizeof(header);
+
+		for (const auto& [key, info] : records)
+		{
+			if (temp.file.write(buf.data() + info.offset, info.size) != info.size)
+			{
+				return false;
+			}
+
+			new_offsets.push_back({pos, info.size});
+			pos += info.size;
+		}
+
+		// Close the file in order to replace it
+		m_file.close();
+
+		if (temp.commit())
+		{
+			for (usz i = 0; i < records.size(); i++)
+			{
+				m_index[*records[i].first] = new_offsets[i];
+			}
+
+			rsx_log.notice("packed_archive: Compacted '%s' (0x%x -> 0x%x bytes)", m_path, m_end, pos);
+
+			m_end = pos;
+			m_dead_bytes = 0;
+		}
+		else
+		{
+			rsx_log.error("packed_archive: Failed to replace '%s' (%s)", m_path, fs::g_tls_error);
+		}
+
+		return m_file.open(m_path, fs::read + fs::write + fs::create + fs::append);
+	}
+
+	usz packed_archive::import_directory(const std::string& path, std::string_view suffix, bool remove_source)
+	{
+		fs::dir root(path);
+
+		if (!root)
+		{
+			return 0;
+		}
+
+		std::vector<std::string> names;
+
+		for (auto&& entry : root)
+		{
+			if (!entry.is_directory && entry.name.ends_with(suffix))
+			{
+				names.push_back(std::move(entry.name));
+			}
+		}
+
+		root.close();
+
+		usz count = 0;
+
+		for (const std::string& name : names)
+		{
+			const std::string file_path = path + "/" + name;
+
+			if (fs::file f{file_path})
+			{
+				const std::vector<u8> data = f.to_vector<u8>();
+				f.close();
+
+				// Only delete sources which are now stored in the archive
+				if (add(name, data))
+				{
+					count++;
+
+					if (remove_source)
+					{
+						fs::remove_file(file_path);
+					}
+				}
+			}
+		}
+
+		return count;
+	}
+}
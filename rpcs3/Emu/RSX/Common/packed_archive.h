@@ -0,0 +1,79 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
+
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rsx
+{
+	// Append-only single-file archive of keyed binary records.
+	// Each record carries its own header and checksum, so the index is rebuilt with one sequential read.
+	class packed_archive
+	{
+		struct record_info
+		{
+			u64 offset;   // Offset of the record header
+			u32 size;     // Total size including header and key
+		};
+
+		fs::file m_file;
+		std::string m_path;
+		bool m_compress = false;
+
+		mutable shared_mutex m_mutex;
+		std::unordered_map<std::string, record_info> m_index;
+
+		// End of the last valid record (next append position)
+		u64 m_end = 0;
+
+		// Bytes occupied by duplicate or broken records
+		u64 m_dead_bytes = 0;
+
+		bool compact_unlocked();
+
+	public:
+		using record_func = std::function<void(std::string_view key, std::span<const u8> data)>;
+
+		packed_archive() = default;
+
+		packed_archive(const packed_archive&) = delete;
+
+		packed_archive& operator=(const packed_archive&) = delete;
+
+		// Open or create the archive. New records are stored as zstd frames if compress is set.
+		bool open(const std::string& path, bool compress = false);
+
+		void close();
+
+		explicit operator bool() const
+		{
+			return m_file.operator bool();
+		}
+
+		usz size() const;
+
+		bool contains(std::string_view key) const;
+
+		// Read one record
+		bool read(std::string_view key, std::vector<u8>& out) const;
+
+		// Visit all records in file order
+		usz for_each(const record_func& func) const;
+
+		// Append a record, returns false if the key already exists or on error
+		bool add(std::string_view key, std::span<const u8> data);
+
+		// Rewrite the archive without duplicate or broken records (atomic)
+		bool compact();
+
+		// One-shot migration of loose files (key = file name), optionally deleting the imported ones
+		usz import_directory(const std::string& path, std::string_view suffix, bool remove_source);
+	};
+}
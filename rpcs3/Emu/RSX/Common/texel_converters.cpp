@@ -0,0 +1,506 @@
+#include "stdafx.h"
+#include "texel_converters.h"
+
+#include "util/sysinfo.hpp"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
+
+#if defined(_MSC_VER) || !defined(__SSE2__)
+#define AVX2_FUNC
+#else
+#define AVX2_FUNC __attribute__((__target__("avx2")))
+#endif
+
+namespace rsx
+{
+	u16 convert_rgb655_to_rgb565(const u16 bits)
+	{
+		// g6 = g5
+		// r5 = (((bits & 0xFC00) >> 1) & 0xFC00) << 1 is equivalent to truncating the least significant bit
+		return (bits & 0xF81F) | (bits & 0x3E0) << 1;
+	}
+
+	u32 convert_rgb565_to_bgra8(const u16 bits)
+	{
+		const u8 r5 = ((bits >> 11) & 0x1F);
+		const u8 g6 = ((bits >> 5) & 0x3F);
+		const u8 b5 = (bits & 0x1F);
+
+		const u8 b8 = ((b5 * 527) + 23) >> 6;
+		const u8 g8 = ((g6 * 259) + 33) >> 6;
+		const u8 r8 = ((r5 * 527) + 23) >> 6;
+		const u8 a8 = 255;
+
+		return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	}
+
+	u32 convert_argb4_to_bgra8(const u16 bits)
+	{
+		const u8 b8 = (bits & 0xF0);
+		const u8 g8 = ((bits >> 4) & 0xF0);
+		const u8 r8 = ((bits >> 8) & 0xF0);
+		const u8 a8 = ((bits << 4) & 0xF0);
+
+		return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	}
+
+	u32 convert_a1rgb5_to_bgra8(const u16 bits)
+	{
+		const u8 a1 = ((bits >> 11) & 0x80);
+		const u8 r5 = ((bits >> 10) & 0x1F);
+		const u8 g5 = ((bits >> 5) & 0x1F);
+		const u8 b5 = (bits & 0x1F);
+
+		const u8 b8 = ((b5 * 527) + 23) >> 6;
+		const u8 g8 = ((g5 * 527) + 23) >> 6;
+		const u8 r8 = ((r5 * 527) + 23) >> 6;
+		const u8 a8 = a1;
+
+		return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	}
+
+	u32 convert_rgb5a1_to_bgra8(const u16 bits)
+	{
+		const u8 r5 = ((bits >> 11) & 0x1F);
+		const u8 g5 = ((bits >> 6) & 0x1F);
+		const u8 b5 = ((bits >> 1) & 0x1F);
+		const u8 a1 = (bits & 0x80);
+
+		const u8 b8 = ((b5 * 527) + 23) >> 6;
+		const u8 g8 = ((g5 * 527) + 23) >> 6;
+		const u8 r8 = ((r5 * 527) + 23) >> 6;
+		const u8 a8 = a1;
+
+		return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	}
+
+	u32 convert_rgb655_to_bgra8(const u16 bits)
+	{
+		const u8 r6 = ((bits >> 10) & 0x3F);
+		const u8 g5 = ((bits >> 5) & 0x1F);
+		const u8 b5 = ((bits) & 0x1F);
+
+		const u8 b8 = ((b5 * 527) + 23) >> 6;
+		const u8 g8 = ((g5 * 527) + 23) >> 6;
+		const u8 r8 = ((r6 * 259) + 33) >> 6;
+		const u8 a8 = 1;
+
+		return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	}
+
+	u32 convert_d1rgb5_to_bgra8(const u16 bits)
+	{
+		const u8 r5 = ((bits >> 10) & 0x1F);
+		const u8 g5 = ((bits >> 5) & 0x1F);
+		const u8 b5 = (bits & 0x1F);
+
+		const u8 b8 = ((b5 * 527) + 23) >> 6;
+		const u8 g8 = ((g5 * 527) + 23) >> 6;
+		const u8 r8 = ((r5 * 527) + 23) >> 6;
+		const u8 a8 = 1;
+
+		return b8 | (g8 << 8) | (r8 << 16) | (a8 << 24);
+	}
+}
+
+namespace
+{
+	using namespace rsx;
+
+	// One 8-bit output channel of a 16-bit texel: ((((x >> shift_right) << shift_left) & mask) * scale + bias) >> scale_shift | fill
+	struct texel_channel
+	{
+		u8 shift_right = 0;
+		u8 shift_left = 0;
+		u16 mask = 0;
+		u16 scale = 1;
+		u16 bias = 0;
+		u8 scale_shift = 0;
+		u16 fill = 0;
+	};
+
+	struct texel_layout
+	{
+		texel_channel b, g, r, a;
+	};
+
+	constexpr texel_channel raw(u8 shift_right, u8 shift_left, u16 mask)
+	{
+		return {shift_right, shift_left, mask};
+	}
+
+	// Same expansions as the scalar converters
+	constexpr texel_channel unorm5(u8 shift_right)
+	{
+		return {shift_right, 0, 0x1F, 527, 23, 6};
+	}
+
+	constexpr texel_channel unorm6(u8 shift_right)
+	{
+		return {shift_right, 0, 0x3F, 259, 33, 6};
+	}
+
+	constexpr texel_channel fill(u16 value)
+	{
+		return {.fill = value};
+	}
+
+	constexpr texel_layout get_layout(texel_conversion conversion)
+	{
+		switch (conversion)
+		{
+		case texel_conversion::rgb565_to_bgra8: return {unorm5(0), unorm6(5), unorm5(11), fill(255)};
+		case texel_conversion::argb4_to_bgra8: return {raw(0, 0, 0xF0), raw(4, 0, 0xF0), raw(8, 0, 0xF0), raw(0, 4, 0xF0)};
+		case texel_conversion::a1rgb5_to_bgra8: return {unorm5(0), unorm5(5), unorm5(10), raw(11, 0, 0x80)};
+		case texel_conversion::rgb5a1_to_bgra8: return {unorm5(1), unorm5(6), unorm5(11), raw(0, 0, 0x80)};
+		case texel_conversion::rgb655_to_bgra8: return {unorm5(0), unorm5(5), unorm6(10), fill(1)};
+		case texel_conversion::d1rgb5_to_bgra8: return {unorm5(0), unorm5(5), unorm5(10), fill(1)};
+		}
+
+		return {};
+	}
+
+	template <texel_conversion Conversion>
+	u32 convert_texel(u16 bits)
+	{
+		if constexpr (Conversion == texel_conversion::rgb565_to_bgra8)
+			return convert_rgb565_to_bgra8(bits);
+		else if constexpr (Conversion == texel_conversion::argb4_to_bgra8)
+			return convert_argb4_to_bgra8(bits);
+		else if constexpr (Conversion == texel_conversion::a1rgb5_to_bgra8)
+			return convert_a1rgb5_to_bgra8(bits);
+		else if constexpr (Conversion == texel_conversion::rgb5a1_to_bgra8)
+			return convert_rgb5a1_to_bgra8(bits);
+		else if constexpr (Conversion == texel_conversion::rgb655_to_bgra8)
+			return convert_rgb655_to_bgra8(bits);
+		else
+			return convert_d1rgb5_to_bgra8(bits);
+	}
+
+	template <texel_conversion Conversion>
+	void convert_row_scalar(u32* dst, const be_t<u16>* src, u32 count)
+	{
+		for (u32 i = 0; i < count; i++)
+		{
+			dst[i] = convert_texel<Conversion>(src[i]);
+		}
+	}
+
+	void convert_rgb655_row_scalar(u16* dst, const be_t<u16>* src, u32 count)
+	{
+		for (u32 i = 0; i < count; i++)
+		{
+			dst[i] = convert_rgb655_to_rgb565(src[i]);
+		}
+	}
+
+	template <bool SwapWords>
+	void convert_rb_rg_row_scalar(u32* dst, const u32* src, u32 count)
+	{
+		for (u32 i = 0; i < count; i++)
+		{
+			const u32 data = src[i];
+			u32 red0, red1, blue, green;
+
+			if constexpr (SwapWords)
+			{
+				// BR_GR
+				blue = (data >> 0) & 0xFF;
+				red0 = (data >> 8) & 0xFF;
+				green = (data >> 16) & 0XFF;
+				red1 = (data >> 24) & 0xFF;
+			}
+			else
+			{
+				// RB_RG
+				red0 = (data >> 0) & 0xFF;
+				blue = (data >> 8) & 0xFF;
+				red1 = (data >> 16) & 0XFF;
+				green = (data >> 24) & 0xFF;
+			}
+
+			dst[i * 2] = blue | (green << 8) | (red0 << 16) | (0xFF << 24);
+			dst[i * 2 + 1] = blue | (green << 8) | (red1 << 16) | (0xFF << 24);
+		}
+	}
+
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+	template <texel_channel C>
+	FORCE_INLINE v128 decode_channel(const v128& x)
+	{
+		if constexpr (!C.mask)
+		{
+			return gv_bcst16(C.fill);
+		}
+		else
+		{
+			v128 v = gv_and32(gv_shl16(gv_shr16(x, C.shift_right), C.shift_left), gv_bcst16(C.mask));
+
+			if constexpr (C.scale != 1)
+			{
+				v = gv_shr16(gv_add16(gv_mul16(v, gv_bcst16(C.scale)), gv_bcst16(C.bias)), C.scale_shift);
+			}
+
+			return v;
+		}
+	}
+
+	template <texel_conversion Conversion>
+	void convert_row_v128(u32* dst, const be_t<u16>* src, u32 count)
+	{
+		constexpr texel_layout layout = get_layout(Conversion);
+
+		u32 i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			const v128 x = gv_rol16<8>(v128::loadu(src + i));
+
+			// Interleave (b | g << 8) and (r | a << 8) into BGRA8
+			const v128 lo = gv_or32(decode_channel<layout.b>(x), gv_shl16(decode_channel<layout.g>(x), 8));
+			const v128 hi = gv_or32(decode_channel<layout.r>(x), gv_shl16(decode_channel<layout.a>(x), 8));
+
+			v128::storeu(gv_unpacklo16(lo, hi), dst + i);
+			v128::storeu(gv_unpackhi16(lo, hi), dst + i + 4);
+		}
+
+		convert_row_scalar<Conversion>(dst + i, src + i, count - i);
+	}
+
+	void convert_rgb655_row_v128(u16* dst, const be_t<u16>* src, u32 count)
+	{
+		u32 i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			const v128 x = gv_rol16<8>(v128::loadu(src + i));
+			v128::storeu(gv_or32(gv_and32(x, gv_bcst16(0xF81F)), gv_shl16(gv_and32(x, gv_bcst16(0x3E0)), 1)), dst + i);
+		}
+
+		convert_rgb655_row_scalar(dst + i, src + i, count - i);
+	}
+
+	template <bool SwapWords>
+	void convert_rb_rg_row_v128(u32* dst, const u32* src, u32 count)
+	{
+		const v128 mask_lo = gv_bcst32(0xFF);
+		const v128 mask_green = gv_bcst32(0xFF00);
+		const v128 mask_red = gv_bcst32(0xFF0000);
+		const v128 alpha = gv_bcst32(0xFF000000);
+
+		u32 i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const v128 data = v128::loadu(src + i);
+			v128 common, red0, red1;
+
+			if constexpr (SwapWords)
+			{
+				common = gv_or32(gv_or32(gv_and32(data, mask_lo), gv_and32(gv_shr32(data, 8), mask_green)), alpha);
+				red0 = gv_and32(gv_shl32(data, 8), mask_red);
+				red1 = gv_and32(gv_shr32(data, 8), mask_red);
+			}
+			else
+			{
+				common = gv_or32(gv_or32(gv_and32(gv_shr32(data, 8), mask_lo), gv_and32(gv_shr32(data, 16), mask_green)), alpha);
+				red0 = gv_and32(gv_shl32(data, 16), mask_red);
+				red1 = gv_and32(data, mask_red);
+			}
+
+			const v128 out0 = gv_or32(common, red0);
+			const v128 out1 = gv_or32(common, red1);
+
+			v128::storeu(gv_unpacklo32(out0, out1), dst + i * 2);
+			v128::storeu(gv_unpackhi32(out0, out1), dst + i * 2 + 4);
+		}
+
+		convert_rb_rg_row_scalar<SwapWords>(dst + i * 2, src + i, count - i);
+	}
+#endif
+
+#if defined(ARCH_X64)
+	AVX2_FUNC FORCE_INLINE __m256i load_bswap16_avx2(const be_t<u16>* src)
+	{
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+		return _mm256_or_si256(_mm256_srli_epi16(x, 8), _mm256_slli_epi16(x, 8));
+	}
+
+	AVX2_FUNC void convert_rgb655_row_avx2(u16* dst, const be_t<u16>* src, u32 count)
+	{
+		u32 i = 0;
+
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m256i x = load_bswap16_avx2(src + i);
+			const __m256i r = _mm256_or_si256(_mm256_and_si256(x, _mm256_set1_epi16(static_cast<s16>(0xF81F))), _mm256_slli_epi16(_mm256_and_si256(x, _mm256_set1_epi16(0x3E0)), 1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+		}
+
+		convert_rgb655_row_v128(dst + i, src + i, count - i);
+	}
+
+	template <bool SwapWords>
+	AVX2_FUNC void convert_rb_rg_row_avx2(u32* dst, const u32* src, u32 count)
+	{
+		const __m256i mask_lo = _mm256_set1_epi32(0xFF);
+		const __m256i mask_green = _mm256_set1_epi32(0xFF00);
+		const __m256i mask_red = _mm256_set1_epi32(0xFF0000);
+		const __m256i alpha = _mm256_set1_epi32(static_cast<s32>(0xFF000000));
+
+		u32 i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			__m256i common, red0, red1;
+
+			if constexpr (SwapWords)
+			{
+				common = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(data, mask_lo), _mm256_and_si256(_mm256_srli_epi32(data, 8), mask_green)), alpha);
+				red0 = _mm256_and_si256(_mm256_slli_epi32(data, 8), mask_red);
+				red1 = _mm256_and_si256(_mm256_srli_epi32(data, 8), mask_red);
+			}
+			else
+			{
+				common = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(data, 8), mask_lo), _mm256_and_si256(_mm256_srli_epi32(data, 16), mask_green)), alpha);
+				red0 = _mm256_and_si256(_mm256_slli_epi32(data, 16), mask_red);
+				red1 = _mm256_and_si256(data, mask_red);
+			}
+
+			const __m256i out0 = _mm256_or_si256(common, red0);
+			const __m256i out1 = _mm256_or_si256(common, red1);
+
+			// Blocks 0-1 and 4-5, then 2-3 and 6-7
+			const __m256i t0 = _mm256_unpacklo_epi32(out0, out1);
+			const __m256i t1 = _mm256_unpackhi_epi32(out0, out1);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), _mm256_permute2x128_si256(t0, t1, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 8), _mm256_permute2x128_si256(t0, t1, 0x31));
+		}
+
+		convert_rb_rg_row_v128<SwapWords>(dst + i * 2, src + i, count - i);
+	}
+#endif
+
+	template <template <texel_conversion> typename Kernel>
+	texel_row_16_to_32_func select_row_converter(texel_conversion conversion)
+	{
+		switch (conversion)
+		{
+		case texel_conversion::rgb565_to_bgra8: return Kernel<texel_conversion::rgb565_to_bgra8>::func;
+		case texel_conversion::argb4_to_bgra8: return Kernel<texel_conversion::argb4_to_bgra8>::func;
+		case texel_conversion::a1rgb5_to_bgra8: return Kernel<texel_conversion::a1rgb5_to_bgra8>::func;
+		case texel_conversion::rgb5a1_to_bgra8: return Kernel<texel_conversion::rgb5a1_to_bgra8>::func;
+		case texel_conversion::rgb655_to_bgra8: return Kernel<texel_conversion::rgb655_to_bgra8>::func;
+		case texel_conversion::d1rgb5_to_bgra8: return Kernel<texel_conversion::d1rgb5_to_bgra8>::func;
+		}
+
+		fmt::throw_exception("Unknown texel conversion %d", static_cast<u32>(conversion));
+	}
+
+	template <texel_conversion Conversion>
+	struct scalar_kernel
+	{
+		static constexpr texel_row_16_to_32_func func = &convert_row_scalar<Conversion>;
+	};
+
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+	template <texel_conversion Conversion>
+	struct v128_kernel
+	{
+		static constexpr texel_row_16_to_32_func func = &convert_row_v128<Conversion>;
+	};
+#endif
+}
+
+namespace rsx
+{
+	bool is_texel_isa_supported(texel_isa isa)
+	{
+		switch (isa)
+		{
+		case texel_isa::scalar:
+			return true;
+		case texel_isa::v128:
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+			return true;
+#else
+			return false;
+#endif
+		case texel_isa::avx2:
+#if defined(ARCH_X64)
+			return utils::has_avx2();
+#else
+			return false;
+#endif
+		}
+
+		return false;
+	}
+
+	texel_isa get_texel_isa()
+	{
+		static const texel_isa s_isa = []()
+		{
+			for (texel_isa isa : {texel_isa::avx2, texel_isa::v128})
+			{
+				if (is_texel_isa_supported(isa))
+				{
+					return isa;
+				}
+			}
+
+			return texel_isa::scalar;
+		}();
+
+		return s_isa;
+	}
+
+	texel_row_16_to_32_func get_texel_row_converter(texel_conversion conversion, texel_isa isa)
+	{
+		ensure(is_texel_isa_supported(isa));
+
+		switch (isa)
+		{
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		// 16 to 32-bit expansion is only used on Apple hosts, it has no AVX2 variant
+		case texel_isa::avx2:
+		case texel_isa::v128: return select_row_converter<v128_kernel>(conversion);
+#endif
+		default: return select_row_converter<scalar_kernel>(conversion);
+		}
+	}
+
+	texel_row_16_to_16_func get_rgb655_to_rgb565_row_converter(texel_isa isa)
+	{
+		ensure(is_texel_isa_supported(isa));
+
+		switch (isa)
+		{
+#if defined(ARCH_X64)
+		case texel_isa::avx2: return &convert_rgb655_row_avx2;
+#endif
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		case texel_isa::v128: return &convert_rgb655_row_v128;
+#endif
+		default: return &convert_rgb655_row_scalar;
+		}
+	}
+
+	texel_row_rb_rg_func get_rb_rg_row_converter(bool swap_words, texel_isa isa)
+	{
+		ensure(is_texel_isa_supported(isa));
+
+		switch (isa)
+		{
+#if defined(ARCH_X64)
+		case texel_isa::avx2: return swap_words ? &convert_rb_rg_row_avx2<true> : &convert_rb_rg_row_avx2<false>;
+#endif
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+		case texel_isa::v128: return swap_words ? &convert_rb_rg_row_v128<true> : &convert_rb_rg_row_v128<false>;
+#endif
+		default: return swap_words ? &convert_rb_rg_row_scalar<true> : &convert_rb_rg_row_scalar<false>;
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/endian.hpp"
+
+namespace rsx
+{
+	// Instruction sets the row converters are built for
+	enum class texel_isa : u8
+	{
+		scalar,
+		v128, // SSE2 or NEON
+		avx2,
+	};
+
+	enum class texel_conversion : u8
+	{
+		rgb565_to_bgra8,
+		argb4_to_bgra8,
+		a1rgb5_to_bgra8,
+		rgb5a1_to_bgra8,
+		rgb655_to_bgra8,
+		d1rgb5_to_bgra8,
+	};
+
+	// Scalar reference converters, one texel each
+	u16 convert_rgb655_to_rgb565(u16 bits);
+	u32 convert_rgb565_to_bgra8(u16 bits);
+	u32 convert_argb4_to_bgra8(u16 bits);
+	u32 convert_a1rgb5_to_bgra8(u16 bits);
+	u32 convert_rgb5a1_to_bgra8(u16 bits);
+	u32 convert_rgb655_to_bgra8(u16 bits);
+	u32 convert_d1rgb5_to_bgra8(u16 bits);
+
+	// Row converters. 16-bit texels are read big-endian as stored in guest memory.
+	using texel_row_16_to_32_func = void(*)(u32* dst, const be_t<u16>* src, u32 count);
+	using texel_row_16_to_16_func = void(*)(u16* dst, const be_t<u16>* src, u32 count);
+
+	// Expands count RB_RG (or BR_GR) blocks into 2 * count BGRA8 texels
+	using texel_row_rb_rg_func = void(*)(u32* dst, const u32* src, u32 count);
+
+	bool is_texel_isa_supported(texel_isa isa);
+
+	// Best instruction set available on the host, detected once
+	texel_isa get_texel_isa();
+
+	texel_row_16_to_32_func get_texel_row_converter(texel_conversion conversion, texel_isa isa = get_texel_isa());
+	texel_row_16_to_16_func get_rgb655_to_rgb565_row_converter(texel_isa isa = get_texel_isa());
+	texel_row_rb_rg_func get_rb_rg_row_converter(bool swap_words, texel_isa isa = get_texel_isa());
+}
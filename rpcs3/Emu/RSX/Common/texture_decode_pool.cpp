@@ -0,0 +1,104 @@
+#include "stdafx.h"
+#include "texture_decode_pool.h"
+
+#include "Utilities/Thread.h"
+#include "util/sysinfo.hpp"
+#include "util/asm.hpp"
+
+namespace rsx
+{
+	void texture_decode_pool::worker_func::operator()() const
+	{
+		for (u32 seq = pool->m_job_seq; thread_ctrl::state() != thread_state::aborting;)
+		{
+			thread_ctrl::wait_on(pool->m_job_seq, seq);
+			seq = pool->m_job_seq;
+
+			reader_lock lock(pool->m_job_mutex);
+
+			if (job_t* job = pool->m_job)
+			{
+				pool->process_tiles(*job);
+			}
+		}
+	}
+
+	texture_decode_pool::texture_decode_pool()
+	{
+		// Leave most of the threads to the emulated processors
+		m_worker_count = std::min<u32>(utils::get_thread_count() / 4, 4);
+
+		if (m_worker_count)
+		{
+			m_workers = std::make_unique<named_thread_group<worker_func>>("RSX Texture Decoder ", m_worker_count, worker_func{this});
+		}
+	}
+
+	texture_decode_pool::~texture_decode_pool()
+	{
+		// Abort and join the workers before the job state is destroyed
+		m_workers.reset();
+	}
+
+	void texture_decode_pool::process_tiles(job_t& job) const
+	{
+		for (u32 tile = job.next++; tile < job.tile_count; tile = job.next++)
+		{
+			const u32 first = tile * job.tile_rows;
+			(*job.func)(first, std::min(job.tile_rows, job.rows - first));
+
+			if (job.done.add_fetch(1) == job.tile_count)
+			{
+				job.done.notify_one();
+			}
+		}
+	}
+
+	bool texture_decode_pool::try_run(u32 rows, usz row_size, const tile_func& func)
+	{
+		if (!m_worker_count || !row_size || rows * row_size < min_job_size)
+		{
+			return false;
+		}
+
+		// Aim for a few tiles per thread so that uneven tiles balance out.
+		// Tiles are capped to 16-bit row counts which is what the texel converters take.
+		const u32 rows_per_thread = utils::aligned_div(rows, (m_worker_count + 1) * 4);
+		const u32 tile_rows = std::clamp<u32>(std::max<u32>(static_cast<u32>(utils::aligned_div<usz>(min_tile_size, row_size)), rows_per_thread), 1, u16{umax});
+		const u32 tile_count = utils::aligned_div(rows, tile_rows);
+
+		if (tile_count < 2)
+		{
+			return false;
+		}
+
+		std::unique_lock submit_lock(m_submit_mutex, std::try_to_lock);
+
+		if (!submit_lock)
+		{
+			return false;
+		}
+
+		job_t job{&func, rows, tile_rows, tile_count};
+
+		{
+			std::lock_guard lock(m_job_mutex);
+			m_job = &job;
+		}
+
+		m_job_seq++;
+		m_job_seq.notify_all();
+
+		process_tiles(job);
+
+		for (u32 done = job.done; done < tile_count; done = job.done)
+		{
+			job.done.wait(done);
+		}
+
+		// Waits for the workers to leave the job
+		std::lock_guard lock(m_job_mutex);
+		m_job = nullptr;
+		return true;
+	}
+}
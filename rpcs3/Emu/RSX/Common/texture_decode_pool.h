@@ -0,0 +1,74 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/atomic.hpp"
+#include "Utilities/mutex.h"
+
+#include <functional>
+#include <memory>
+
+template <class Context>
+class named_thread_group;
+
+namespace rsx
+{
+	// Persistent workers used to split large software texture decodes into tiles.
+	// The submitting thread processes tiles as well and returns once all of them are done.
+	class texture_decode_pool
+	{
+	public:
+		// Receives a range of rows [first, first + count)
+		using tile_func = std::function<void(u32 first, u32 count)>;
+
+		// Decodes producing less output than this stay inline on the calling thread
+		static constexpr usz min_job_size = 256 * 1024;
+
+		// Minimum output size of a single tile
+		static constexpr usz min_tile_size = 32 * 1024;
+
+	private:
+		struct job_t
+		{
+			const tile_func* func;
+			u32 rows;
+			u32 tile_rows;
+			u32 tile_count;
+			atomic_t<u32> next = 0;
+			atomic_t<u32> done = 0;
+		};
+
+		struct worker_func
+		{
+			texture_decode_pool* pool;
+
+			void operator()() const;
+		};
+
+		shared_mutex m_submit_mutex;
+
+		// Held shared by workers while they access m_job
+		shared_mutex m_job_mutex;
+		job_t* m_job = nullptr;
+		atomic_t<u32> m_job_seq = 0;
+
+		u32 m_worker_count = 0;
+
+		// Must be destroyed first
+		std::unique_ptr<named_thread_group<worker_func>> m_workers;
+
+		void process_tiles(job_t& job) const;
+
+	public:
+		texture_decode_pool();
+
+		texture_decode_pool(const texture_decode_pool&) = delete;
+
+		texture_decode_pool& operator=(const texture_decode_pool&) = delete;
+
+		~texture_decode_pool();
+
+		// Split rows into tiles of row_size bytes each and run func over them.
+		// Returns false without calling func if the job is too small, no workers exist or the pool is busy.
+		bool try_run(u32 rows, usz row_size, const tile_func& func);
+	};
+}
@@ -4,8 +4,13 @@
 #include "Emu/system_config.h"
 #include "GLCommonDecompiler.h"
 #include "../Program/GLSLCommon.h"
+#include "../Program/program_source_cache.h"
 #include "../RSXThread.h"
 
+#include "util/fnv_hash.hpp"
+
+#include <chrono>
+
 std::string GLFragmentDecompilerThread::getFloatTypeName(usz elementCount)
 {
 	return glsl::getFloatTypeNameImpl(elementCount);
@@ -381,16 +386,43 @@ void GLFragmentProgram::Decompile(const RSXFragmentProgram& prog)
 	std::string source;
 	GLFragmentDecompilerThread decompiler(source, parr, prog, size);
 
+	const auto& driver_caps = gl::get_driver_caps();
+
 	if (g_cfg.video.shader_precision == gpu_preset_level::low)
 	{
-		const auto& driver_caps = gl::get_driver_caps();
 		decompiler.device_props.has_native_half_support = driver_caps.NV_gpu_shader5_supported || driver_caps.AMD_gpu_shader_half_float_supported;
 		decompiler.device_props.has_low_precision_rounding = driver_caps.vendor_NVIDIA;
 	}
 
-	decompiler.Task();
+	// Everything besides the program itself that affects the decompiled source
+	usz state_hash = rpcs3::hash64(rpcs3::fnv_seed, static_cast<u32>(g_cfg.video.shader_precision.get()));
+	state_hash = rpcs3::hash64(state_hash, driver_caps.glsl_version.version);
+	state_hash = rpcs3::hash64(state_hash, u32{driver_caps.NV_gpu_shader5_supported} | u32{driver_caps.AMD_gpu_shader_half_float_supported} << 1 | u32{driver_caps.vendor_NVIDIA} << 2);
+	state_hash = rpcs3::hash64(state_hash, u32{decompiler.device_props.has_native_half_support} | u32{decompiler.device_props.has_low_precision_rounding} << 1);
+
+	auto* source_cache = g_fxo->try_get<rsx::program_source_cache>();
+	const auto key = source_cache ? rsx::program_source_cache::get_key(prog, state_hash) : rsx::program_source_cache::key_t{};
+
+	if (rsx::program_source_cache::entry cached; source_cache && source_cache->find(key, cached))
+	{
+		source = std::move(cached.source);
+		constant_offsets = std::move(cached.metadata);
+	}
+	else
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		decompiler.Task();
+
+		constant_offsets = std::move(decompiler.properties.constant_offsets);
+
+		if (source_cache)
+		{
+			const u64 elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			source_cache->store(key, {source, constant_offsets}, elapsed_ns);
+		}
+	}
 
-	constant_offsets = std::move(decompiler.properties.constant_offsets);
 	shader.create(::glsl::program_domain::glsl_fragment_program, source);
 	id = shader.id();
 }
@@ -10,6 +10,7 @@
 #include "Emu/RSX/rsx_methods.h"
 #include "Emu/RSX/Host/MM.h"
 #include "Emu/RSX/Host/RSXDMAWriter.h"
+#include "Emu/RSX/Program/program_source_cache.h"
 #include "Emu/RSX/NV47/HW/context_accessors.define.h"
 
 [[noreturn]] extern void report_fatal_error(std::string_view _text, bool is_html = false, bool include_help_text = true);
@@ -41,6 +42,8 @@ u64 GLGSRender::get_cycles()
 GLGSRender::GLGSRender(utils::serial* ar) noexcept : GSRender(ar)
 {
 	m_shaders_cache = std::make_unique<gl::shader_cache>(m_prog_buffer, "opengl", "v1.95");
+	g_fxo->need<rsx::program_source_cache>();
+	g_fxo->get<rsx::program_source_cache>().open("opengl");
 
 	if (g_cfg.video.disable_vertex_cache)
 		m_vertex_cache = std::make_unique<gl::null_vertex_cache>();
@@ -2,9 +2,15 @@
 #include "GLVertexProgram.h"
 
 #include "Emu/system_config.h"
+#include "Emu/IdManager.h"
 
 #include "GLCommonDecompiler.h"
 #include "../Program/GLSLCommon.h"
+#include "../Program/program_source_cache.h"
+
+#include "util/fnv_hash.hpp"
+
+#include <chrono>
 
 std::string GLVertexDecompilerThread::getFloatTypeName(usz elementCount)
 {
@@ -319,10 +325,41 @@ void GLVertexProgram::Decompile(const RSXVertexProgram& prog)
 {
 	std::string source;
 	GLVertexDecompilerThread decompiler(prog, source, parr);
-	decompiler.Task();
 
-	has_indexed_constants = decompiler.properties.has_indexed_constants;
-	constant_ids = std::vector<u16>(decompiler.m_constant_ids.begin(), decompiler.m_constant_ids.end());
+	const auto& driver_caps = gl::get_driver_caps();
+
+	// Everything besides the program itself that affects the decompiled source
+	usz state_hash = rpcs3::hash64(rpcs3::fnv_seed, static_cast<u32>(g_cfg.video.shader_precision.get()));
+	state_hash = rpcs3::hash64(state_hash, u32{driver_caps.vendor_MESA} | u32{driver_caps.vendor_NVIDIA} << 1 | u32{driver_caps.NV_depth_buffer_float_supported} << 2);
+
+	auto* source_cache = g_fxo->try_get<rsx::program_source_cache>();
+	const auto key = source_cache ? rsx::program_source_cache::get_key(prog, state_hash) : rsx::program_source_cache::key_t{};
+
+	// Metadata layout: has_indexed_constants, constant ids
+	if (rsx::program_source_cache::entry cached; source_cache && source_cache->find(key, cached, 1))
+	{
+		source = std::move(cached.source);
+		has_indexed_constants = !!cached.metadata[0];
+		constant_ids = std::vector<u16>(cached.metadata.begin() + 1, cached.metadata.end());
+	}
+	else
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		decompiler.Task();
+
+		has_indexed_constants = decompiler.properties.has_indexed_constants;
+		constant_ids = std::vector<u16>(decompiler.m_constant_ids.begin(), decompiler.m_constant_ids.end());
+
+		if (source_cache)
+		{
+			const u64 elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+			rsx::program_source_cache::entry data{source, {u32{has_indexed_constants}}};
+			data.metadata.insert(data.metadata.end(), constant_ids.begin(), constant_ids.end());
+			source_cache->store(key, data, elapsed_ns);
+		}
+	}
 
 	shader.create(::glsl::program_domain::glsl_vertex_program, source);
 	id = shader.id();
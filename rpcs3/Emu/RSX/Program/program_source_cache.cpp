@@ -0,0 +1,230 @@
+#include "stdafx.h"
+#include "program_source_cache.h"
+#include "ProgramStateCache.h"
+
+#include "Emu/cache_utils.hpp"
+#include "Emu/system_config.h"
+#include "Crypto/sha1.h"
+#include "util/fnv_hash.hpp"
+
+namespace rsx
+{
+	program_source_cache::~program_source_cache()
+	{
+		if (const u64 total = m_hits + m_misses)
+		{
+			rsx_log.notice("Program source cache: %u hits, %u misses (%u%%), ~%ums of decompilation saved", m_hits, m_misses, m_hits * 100 / total, get_saved_ns() / 1'000'000);
+		}
+	}
+
+	bool program_source_cache::open(std::string_view backend)
+	{
+		if (g_cfg.video.disable_on_disk_shader_cache)
+		{
+			return false;
+		}
+
+		const std::string cache_path = rpcs3::cache::get_ppu_cache();
+
+		if (cache_path.empty())
+		{
+			return false;
+		}
+
+		const std::string root_path = cache_path + "shaders_cache/";
+		fs::create_path(root_path);
+
+		return m_archive.open(fmt::format("%s%s-source-v%u.pack", root_path, backend, version), true);
+	}
+
+	bool program_source_cache::find(const key_t& key, entry& out, u32 min_metadata)
+	{
+		std::vector<u8> data;
+
+		if (!m_archive || !m_archive.read(key.name, data))
+		{
+			m_misses++;
+			return false;
+		}
+
+		// Layout: digest, source size, source, metadata count, metadata
+		if (data.size() < key.digest.size() || std::memcmp(data.data(), key.digest.data(), key.digest.size()) != 0)
+		{
+			rsx_log.warning("Program source cache: digest mismatch for %s", key.name);
+			m_misses++;
+			return false;
+		}
+
+		usz pos = key.digest.size();
+
+		const auto read_u32 = [&](u32& value)
+		{
+			if (data.size() - pos < sizeof(u32))
+			{
+				return false;
+			}
+
+			value = read_from_ptr<le_t<u32>>(data.data() + pos);
+			pos += sizeof(u32);
+			return true;
+		};
+
+		u32 source_size = 0;
+		u32 metadata_count = 0;
+
+		if (!read_u32(source_size) || data.size() - pos < source_size)
+		{
+			m_misses++;
+			return false;
+		}
+
+		out.source.assign(reinterpret_cast<const char*>(data.data() + pos), source_size);
+		pos += source_size;
+
+		if (!read_u32(metadata_count) || (data.size() - pos) / sizeof(u32) < metadata_count || metadata_count < min_metadata)
+		{
+			m_misses++;
+			return false;
+		}
+
+		out.metadata.resize(metadata_count);
+
+		for (u32& value : out.metadata)
+		{
+			read_u32(value);
+		}
+
+		m_hits++;
+		return true;
+	}
+
+	void program_source_cache::store(const key_t& key, const entry& data, u64 decompile_ns)
+	{
+		m_decompile_ns += decompile_ns;
+
+		if (!m_archive)
+		{
+			return;
+		}
+
+		std::vector<u8> buf(key.digest.size() + sizeof(u32) * 2 + data.source.size() + data.metadata.size() * sizeof(u32));
+		u8* ptr = buf.data();
+
+		std::memcpy(ptr, key.digest.data(), key.digest.size());
+		ptr += key.digest.size();
+		write_to_ptr<le_t<u32>>(ptr, ::size32(data.source));
+		ptr += sizeof(u32);
+		std::memcpy(ptr, data.source.data(), data.source.size());
+		ptr += data.source.size();
+		write_to_ptr<le_t<u32>>(ptr, ::size32(data.metadata));
+		ptr += sizeof(u32);
+
+		for (u32 value : data.metadata)
+		{
+			write_to_ptr<le_t<u32>>(ptr, value);
+			ptr += sizeof(u32);
+		}
+
+		m_archive.add(key.name, buf);
+	}
+
+	program_source_cache::key_t program_source_cache::get_key(const RSXVertexProgram& prog, u64 state_hash)
+	{
+		usz hash = program_hash_util::vertex_program_storage_hash{}(prog);
+		hash = rpcs3::hash64(hash, prog.entry);
+		hash = rpcs3::hash64(hash, prog.base_address);
+
+		for (u32 address : prog.jump_table)
+		{
+			hash = rpcs3::hash64(hash, address);
+		}
+
+		key_t result{fmt::format("vp-%016llx-%016llx", hash, state_hash)};
+
+		// Same inputs as vertex_program_compare, only instructions in use are part of the program
+		sha1_context ctx;
+		sha1_starts(&ctx);
+
+		const auto update = [&](const auto& value)
+		{
+			sha1_update(&ctx, reinterpret_cast<const u8*>(&value), sizeof(value));
+		};
+
+		update(state_hash);
+		update(prog.ctrl);
+		update(prog.output_mask);
+		update(prog.texture_state.texture_dimensions);
+		update(prog.texture_state.multisampled_textures);
+		update(prog.entry);
+		update(prog.base_address);
+		update(prog.jump_table.size());
+
+		for (u32 address : prog.jump_table)
+		{
+			update(address);
+		}
+
+		update(prog.data.size());
+
+		for (u32 index = 0; index < prog.data.size() / 4; index++)
+		{
+			if (prog.instruction_mask[index])
+			{
+				update(index);
+				sha1_update(&ctx, reinterpret_cast<const u8*>(prog.data.data() + index * 4), 16);
+			}
+		}
+
+		sha1_finish(&ctx, result.digest.data());
+		return result;
+	}
+
+	program_source_cache::key_t program_source_cache::get_key(const RSXFragmentProgram& prog, u64 state_hash)
+	{
+		const usz hash = program_hash_util::fragment_program_storage_hash{}(prog);
+
+		key_t result{fmt::format("fp-%016llx-%016llx", hash, state_hash)};
+
+		// Same inputs as fragment_program_compare, embedded constants are not part of the program
+		sha1_context ctx;
+		sha1_starts(&ctx);
+
+		const auto update = [&](const auto& value)
+		{
+			sha1_update(&ctx, reinterpret_cast<const u8*>(&value), sizeof(value));
+		};
+
+		update(state_hash);
+		update(prog.ucode_length);
+		update(prog.ctrl);
+		update(prog.two_sided_lighting);
+		update(prog.texture_state.texture_dimensions);
+		update(prog.texture_state.redirected_textures);
+		update(prog.texture_state.shadow_textures);
+		update(prog.texture_state.multisampled_textures);
+		update(prog.texcoord_control_mask);
+		update(prog.mrt_buffers_count);
+
+		const u8* ucode = static_cast<const u8*>(prog.get_data());
+
+		for (u32 index = 0; index < prog.ucode_length / 16; index++)
+		{
+			const v128 inst = v128::loadu(ucode, index);
+			update(inst);
+
+			if (program_hash_util::fragment_program_utils::is_any_src_constant(inst))
+			{
+				index++;
+			}
+		}
+
+		sha1_finish(&ctx, result.digest.data());
+		return result;
+	}
+
+	u64 program_source_cache::get_saved_ns() const
+	{
+		const u64 misses = m_misses;
+		return misses ? m_hits * (m_decompile_ns / misses) : 0;
+	}
+}
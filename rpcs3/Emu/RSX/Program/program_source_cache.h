@@ -0,0 +1,76 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/atomic.hpp"
+#include "Emu/RSX/Common/packed_archive.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct RSXVertexProgram;
+struct RSXFragmentProgram;
+
+namespace rsx
+{
+	// Persistent cache of decompiled shader source.
+	// Keyed by the program storage hash (ucode and program state) and a backend-provided device state hash.
+	// Records also hold a SHA-1 of everything the program cache compares, so that 64-bit hash collisions are rejected.
+	class program_source_cache
+	{
+		packed_archive m_archive;
+
+		atomic_t<u64> m_hits = 0;
+		atomic_t<u64> m_misses = 0;
+		atomic_t<u64> m_decompile_ns = 0; // Time spent decompiling on misses
+
+	public:
+		struct entry
+		{
+			std::string source;
+			std::vector<u32> metadata; // Backend-specific decompiler outputs
+		};
+
+		struct key_t
+		{
+			std::string name; // Archive entry name
+			std::array<u8, 20> digest{}; // Verified on hits
+		};
+
+		// Bump whenever a decompiler change may alter the emitted source for the same input
+		static constexpr u32 version = 2;
+
+		program_source_cache() = default;
+
+		program_source_cache(const program_source_cache&) = delete;
+
+		program_source_cache& operator=(const program_source_cache&) = delete;
+
+		~program_source_cache();
+
+		// Open the on-disk storage of the current title for the backend
+		bool open(std::string_view backend);
+
+		// Counts a hit or a miss, records with less than min_metadata values are misses
+		bool find(const key_t& key, entry& out, u32 min_metadata = 0);
+
+		void store(const key_t& key, const entry& data, u64 decompile_ns);
+
+		static key_t get_key(const RSXVertexProgram& prog, u64 state_hash);
+		static key_t get_key(const RSXFragmentProgram& prog, u64 state_hash);
+
+		u64 get_hits() const
+		{
+			return m_hits;
+		}
+
+		u64 get_misses() const
+		{
+			return m_misses;
+		}
+
+		// Estimated CPU time saved by hits, in nanoseconds
+		u64 get_saved_ns() const;
+	};
+}
@@ -3,6 +3,7 @@
 
 #include "Capture/rsx_capture.h"
 #include "Common/surface_store.h"
+#include "Common/texture_decode_pool.h"
 #include "Core/RSXReservationLock.hpp"
 #include "Core/RSXEngLock.hpp"
 #include "Host/MM.h"
@@ -708,6 +709,8 @@ namespace rsx
 
 		m_draw_processor.init(m_ctx);
 
+		g_fxo->need<rsx::texture_decode_pool>();
+
 		if (g_cfg.misc.use_native_interface && (g_cfg.video.renderer == video_renderer::opengl || g_cfg.video.renderer == video_renderer::vulkan))
 		{
 			m_overlay_manager = g_fxo->init<rsx::overlays::display_manager>(0);
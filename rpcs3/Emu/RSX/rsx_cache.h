@@ -5,6 +5,7 @@
 #include "Utilities/Thread.h"
 #include "Common/bitfield.hpp"
 #include "Common/unordered_map.hpp"
+#include "Common/packed_archive.h"
 #include "Emu/System.h"
 #include "Emu/cache_utils.hpp"
 #include "Emu/RSX/Program/RSXVertexProgram.h"
@@ -71,6 +72,12 @@ namespace rsx
 		std::string pipeline_class_name;
 		lf_fifo<std::unique_ptr<u8[]>, 100> fragment_program_data;
 
+		// Pipeline records (key is the legacy file name)
+		packed_archive m_pipelines;
+
+		// Raw vertex and fragment program ucode, shared by all pipeline classes
+		packed_archive m_raw_programs;
+
 		backend_storage& m_storage;
 
 		static std::string get_message(u32 index, u32 processed, u32 entry_count)
@@ -78,8 +85,7 @@ namespace rsx
 			return fmt::format("%s pipeline object %u of %u", index == 0 ? "Loading" : "Compiling", processed, entry_count);
 		}
 
-		void load_shaders(uint nb_workers, unpacked_type& unpacked, std::string& directory_path, std::vector<fs::dir_entry>& entries, u32 entry_count,
-		    shader_loading_dialog* dlg)
+		void load_shaders(uint nb_workers, unpacked_type& unpacked, std::vector<pipeline_data>& entries, u32 entry_count, shader_loading_dialog* dlg)
 		{
 			atomic_t<u32> processed(0);
 
@@ -89,28 +95,7 @@ namespace rsx
 				// Processed is incremented before work starts in order to avoid two workers working on the same shader
 				while (((pos = processed++) < stop_at) && !Emu.IsStopped())
 				{
-					fs::dir_entry tmp = entries[pos];
-
-					const auto filename = directory_path + "/" + tmp.name;
-					fs::file f(filename);
-
-					if (!f)
-					{
-						// Unexpected error, but avoid crash
-						continue;
-					}
-
-					if (f.size() != sizeof(pipeline_data))
-					{
-						rsx_log.error("Removing cached pipeline object %s since it's not binary compatible with the current shader cache", tmp.name.c_str());
-						fs::remove_file(filename);
-						continue;
-					}
-
-					pipeline_data pdata{};
-					f.read(&pdata, f.size());
-
-					auto entry = unpack(pdata);
+					auto entry = unpack(entries[pos]);
 
 					if (std::get<1>(entry).data.empty() || !std::get<2>(entry).ucode_length)
 					{
@@ -219,44 +204,67 @@ namespace rsx
 					root_path = std::move(cache_path) + "shaders_cache/";
 				}
 			}
-		}
 
-		template <typename... Args>
-		void load(shader_loading_dialog* dlg, Args&& ...args)
-		{
 			if (root_path.empty())
 			{
 				return;
 			}
 
-			std::string directory_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix;
+			const std::string class_path = root_path + "pipelines/" + pipeline_class_name;
+			const std::string directory_path = class_path + "/" + version_prefix;
+			const std::string raw_path = root_path + "raw";
 
-			fs::dir root = fs::dir(directory_path);
+			fs::create_path(class_path);
 
-			if (!root)
+			if (!m_pipelines.open(directory_path + ".pack") || !m_raw_programs.open(root_path + "raw.pack", true))
 			{
-				fs::create_path(directory_path);
-				fs::create_path(root_path + "/raw");
+				root_path.clear();
 				return;
 			}
 
-			std::vector<fs::dir_entry> entries;
+			// One-shot migration of the one-file-per-object layout
+			if (fs::is_dir(raw_path))
+			{
+				const usz count = m_raw_programs.import_directory(raw_path, ".vp", true) + m_raw_programs.import_directory(raw_path, ".fp", true);
+				fs::remove_dir(raw_path);
+				rsx_log.notice("shaders_cache: Migrated %u raw programs to %s", count, root_path + "raw.pack");
+			}
 
-			for (auto&& tmp : root)
+			if (fs::is_dir(directory_path))
 			{
-				if (tmp.is_directory)
-					continue;
+				const usz count = m_pipelines.import_directory(directory_path, ".bin", true);
+				fs::remove_dir(directory_path);
+				rsx_log.notice("shaders_cache: Migrated %u pipeline objects to %s", count, directory_path + ".pack");
+			}
+		}
 
-				entries.push_back(tmp);
+		template <typename... Args>
+		void load(shader_loading_dialog* dlg, Args&& ...args)
+		{
+			if (root_path.empty())
+			{
+				return;
 			}
 
+			std::vector<pipeline_data> entries;
+
+			// Single sequential read of the archive
+			m_pipelines.for_each([&](std::string_view key, std::span<const u8> data)
+			{
+				if (data.size() != sizeof(pipeline_data))
+				{
+					rsx_log.error("Skipping cached pipeline object %s since it's not binary compatible with the current shader cache", key);
+					return;
+				}
+
+				std::memcpy(&entries.emplace_back(), data.data(), sizeof(pipeline_data));
+			});
+
 			u32 entry_count = ::size32(entries);
 
 			if (!entry_count)
 				return;
 
-			root.rewind();
-
 			// Progress dialog
 			std::unique_ptr<shader_loading_dialog> fallback_dlg;
 			if (!dlg)
@@ -275,7 +283,7 @@ namespace rsx
 			unpacked_type unpacked;
 			uint nb_workers = g_cfg.video.renderer == video_renderer::vulkan ? utils::get_thread_count() : 1;
 
-			load_shaders(nb_workers, unpacked, directory_path, entries, entry_count, dlg);
+			load_shaders(nb_workers, unpacked, entries, entry_count, dlg);
 
 			// Account for any invalid entries
 			entry_count = unpacked.size();
@@ -301,19 +309,18 @@ namespace rsx
 
 			pipeline_data data = pack(pipeline, vp, fp);
 
-			std::string fp_name = root_path + "/raw/" + fmt::format("%llX.fp", data.fragment_program_hash);
-			std::string vp_name = root_path + "/raw/" + fmt::format("%llX.vp", data.vertex_program_hash);
+			const std::string fp_name = fmt::format("%llX.fp", data.fragment_program_hash);
+			const std::string vp_name = fmt::format("%llX.vp", data.vertex_program_hash);
 
-			// Writeback to cache either if file does not exist or it is invalid (unexpected size)
-			// Note: fs::write_file is not atomic, if the process is terminated in the middle an empty file is created
-			if (fs::stat_t s{}; !fs::get_stat(fp_name, s) || s.size != fp.ucode_length)
+			// Records are checksummed, existing ones are always valid
+			if (!m_raw_programs.contains(fp_name))
 			{
-				fs::write_file(fp_name, fs::rewrite, fp.get_data(), fp.ucode_length);
+				m_raw_programs.add(fp_name, {static_cast<const u8*>(fp.get_data()), fp.ucode_length});
 			}
 
-			if (fs::stat_t s{}; !fs::get_stat(vp_name, s) || s.size != vp.data.size() * sizeof(u32))
+			if (!m_raw_programs.contains(vp_name))
 			{
-				fs::write_file(vp_name, fs::rewrite, vp.data);
+				m_raw_programs.add(vp_name, {reinterpret_cast<const u8*>(vp.data.data()), vp.data.size() * sizeof(u32)});
 			}
 
 			const u32 state_params[] =
@@ -336,36 +343,38 @@ namespace rsx
 			const usz state_hash = rpcs3::hash_array(state_params);
 
 			const std::string pipeline_file_name = fmt::format("%llX+%llX+%llX+%llX.bin", data.vertex_program_hash, data.fragment_program_hash, data.pipeline_storage_hash, state_hash);
-			const std::string pipeline_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix + "/" + pipeline_file_name;
-			fs::write_file(pipeline_path, fs::rewrite, &data, sizeof(data));
+			m_pipelines.add(pipeline_file_name, {reinterpret_cast<const u8*>(&data), sizeof(data)});
 		}
 
 		RSXVertexProgram load_vp_raw(u64 program_hash) const
 		{
 			RSXVertexProgram vp = {};
 
-			fs::file f(fmt::format("%s/raw/%llX.vp", root_path, program_hash));
-			if (f) f.read(vp.data, f.size() / sizeof(u32));
+			if (std::vector<u8> buf; m_raw_programs.read(fmt::format("%llX.vp", program_hash), buf))
+			{
+				vp.data.resize(buf.size() / sizeof(u32));
+				std::memcpy(vp.data.data(), buf.data(), vp.data.size() * sizeof(u32));
+			}
 
 			return vp;
 		}
 
 		RSXFragmentProgram load_fp_raw(u64 program_hash)
 		{
-			fs::file f(fmt::format("%s/raw/%llX.fp", root_path, program_hash));
-
 			RSXFragmentProgram fp = {};
 
-			const u32 size = fp.ucode_length = f ? ::size32(f) : 0;
+			std::vector<u8> ucode;
 
-			if (!size)
+			if (!m_raw_programs.read(fmt::format("%llX.fp", program_hash), ucode) || ucode.empty())
 			{
 				return fp;
 			}
 
+			const u32 size = fp.ucode_length = ::size32(ucode);
+
 			auto buf = std::make_unique<u8[]>(size);
 			fp.data = buf.get();
-			f.read(buf.get(), size);
+			std::memcpy(buf.get(), ucode.data(), size);
 			fragment_program_data[fragment_program_data.push_begin()] = std::move(buf);
 			return fp;
 		}
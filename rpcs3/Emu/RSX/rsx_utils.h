@@ -417,24 +417,19 @@ namespace rsx
 	 * Z ordering is done in all 3 planes independently with a unit being a 2x2 block per-plane
 	 * A unit in 3d textures is a group of 2x2x2 texels advancing towards depth in units of 2x2x1 blocks
 	 * i.e 32 texels per "unit"
+	 * Output slices are independent, this overload only writes slices [first_slice, first_slice + slice_count) of the output
 	 */
 	template <typename T>
-	void convert_linear_swizzle_3d(const void* input_pixels, void* output_pixels, u16 width, u16 height, u16 depth)
+	void convert_linear_swizzle_3d(const void* input_pixels, void* output_pixels, u16 width, u16 height, u16 depth, u16 first_slice, u16 slice_count)
 	{
-		if (depth == 1)
-		{
-			convert_linear_swizzle<T, true>(input_pixels, output_pixels, width, height, width * sizeof(T));
-			return;
-		}
-
 		auto src = static_cast<const T*>(input_pixels);
-		auto dst = static_cast<T*>(output_pixels);
+		auto dst = static_cast<T*>(output_pixels) + usz{width} * height * first_slice;
 
 		const u32 log2_w = ceil_log2(width);
 		const u32 log2_h = ceil_log2(height);
 		const u32 log2_d = ceil_log2(depth);
 
-		for (u32 z = 0; z < depth; ++z)
+		for (u32 z = first_slice; z < u32{first_slice} + slice_count; ++z)
 		{
 			for (u32 y = 0; y < height; ++y)
 			{
@@ -446,6 +441,18 @@ namespace rsx
 		}
 	}
 
+	template <typename T>
+	void convert_linear_swizzle_3d(const void* input_pixels, void* output_pixels, u16 width, u16 height, u16 depth)
+	{
+		if (depth == 1)
+		{
+			convert_linear_swizzle<T, true>(input_pixels, output_pixels, width, height, width * sizeof(T));
+			return;
+		}
+
+		convert_linear_swizzle_3d<T>(input_pixels, output_pixels, width, height, depth, 0, depth);
+	}
+
 	void convert_scale_image(u8 *dst, AVPixelFormat dst_format, int dst_width, int dst_height, int dst_pitch,
 		const u8 *src, AVPixelFormat src_format, int src_width, int src_height, int src_pitch, int src_slice_h, bool bilinear);
 
@@ -1088,6 +1088,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 
 		m_state_inspection_savestate = g_cfg.savestate.state_inspection_mode.get();
 		m_savestate_extension_flags1 = {};
+		m_savestate_base_path.clear();
 
 		bool resolve_path_as_vfs_path = false;
 
@@ -1150,6 +1151,15 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 				savestate_app_title = m_ar->pop<std::string>();
 				m_ar->pop<std::string>(); // User note (unused)
 
+				if (GET_SERIALIZATION_VERSION(global_version) >= 20)
+				{
+					// File name of the base of incremental savestates, in the same directory
+					if (const std::string base_name = m_ar->pop<std::string>(); !base_name.empty())
+					{
+						m_savestate_base_path = fs::get_parent_dir(m_path) + "/" + base_name;
+					}
+				}
+
 				(is_incompatible ? sys_log.error : sys_log.success)("Savestate information: creation time: %s, RPCS3 build: \"%s\"\nGame/Title: \"%s\"", savestate_creation_date, savestate_build_version, savestate_app_title);
 			}
 
@@ -2225,7 +2235,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 				sys_log.warning("State Inspection Savestate Mode!");
 
 				vm::init();
-				vm::load(*m_ar);
+				vm::load(*m_ar, m_savestate_base_path);
 
 				if (!hdd1.empty())
 				{
@@ -2307,7 +2317,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 		{
 			if (m_ar)
 			{
-				vm::load(*m_ar);
+				vm::load(*m_ar, m_savestate_base_path);
 			}
 
 			// Mount /host_root/ if necessary (special value)
@@ -3470,6 +3480,11 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 
 		std::string path;
 
+		// Base of incremental savestates: the one this savestate depends on, or a copy of this savestate to make
+		const bool incremental_savestate = g_cfg.savestate.incremental;
+		std::string savestate_base_path;
+		bool make_savestate_base = false;
+
 		static_cast<void>(init_mtx->init());
 
 		// Call explcit semi-destructors (free memory before savestate)
@@ -3630,6 +3645,19 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 				ar(GetTitleAndTitleID());
 				ar(std::string{}); // Possible user note
 
+				if (incremental_savestate)
+				{
+					savestate_base_path = vm::get_savestate_base();
+
+					if (savestate_base_path.empty())
+					{
+						make_savestate_base = true;
+						savestate_base_path = path.substr(0, path.rfind(".SAVESTAT")) + ".base.zst";
+					}
+				}
+
+				ar(savestate_base_path.empty() ? std::string{} : savestate_base_path.substr(savestate_base_path.find_last_of(fs::delim) + 1));
+
 				ar(std::array<u8, 32>{}); // Reserved for future use
 
 				// Game mounted from archive
@@ -3668,7 +3696,7 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 				ar(std::array<u8, 32>{}); // Reserved for future use
 
 				set_progress_message("Saving VMemory");
-				vm::save(ar);
+				vm::save(ar, incremental_savestate);
 
 				set_progress_message("Saving FXO");
 				g_fxo->save(ar);
@@ -3743,6 +3771,20 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 
 				sys_log.success("Saved savestate! path='%s' (file_size=0x%x (%d MiB), time_to_save=%gs)", path, file_stat.size, utils::aligned_div<u64>(file_stat.size, 1u << 20), (get_system_time() - start_time) / 1000000.);
 
+				if (make_savestate_base)
+				{
+					// Keep a copy apart from the savestate files, incremental savestates depend on it until no savestate refers to it
+					// The base is recorded again when booting from this savestate
+					if (fs::copy_file(path, savestate_base_path, true))
+					{
+						sys_log.success("Created the base of incremental savestates: path='%s'", savestate_base_path);
+					}
+					else
+					{
+						sys_log.error("Failed to create the base of incremental savestates! (path='%s', %s)", savestate_base_path, fs::g_tls_error);
+					}
+				}
+
 				if (!g_cfg.savestate.suspend_emu)
 				{
 					// Allow to reboot from GUI
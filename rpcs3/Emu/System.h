@@ -195,6 +195,7 @@ class Emulator final
 	};
 
 	bs_t<SaveStateExtentionFlags1> m_savestate_extension_flags1{};
+	std::string m_savestate_base_path; // Base of incremental savestates (of the savestate being loaded)
 	emu_precompilation_option_t m_precompilation_option{};
 
 public:
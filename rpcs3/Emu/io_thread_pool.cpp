@@ -0,0 +1,89 @@
+#include "stdafx.h"
+#include "io_thread_pool.h"
+
+#include "Utilities/Thread.h"
+#include "util/sysinfo.hpp"
+
+void io_thread_pool::worker_func::operator()() const
+{
+	// Start from 0 so that the job which started the workers is not missed
+	for (u32 seq = 0; thread_ctrl::state() != thread_state::aborting;)
+	{
+		thread_ctrl::wait_on(pool->m_job_seq, seq);
+		seq = pool->m_job_seq;
+
+		reader_lock lock(pool->m_job_mutex);
+
+		if (job_t* job = pool->m_job)
+		{
+			pool->process_chunks(*job);
+		}
+	}
+}
+
+io_thread_pool::io_thread_pool()
+{
+	// Host I/O mostly waits, but keep the threads left to the emulated processors
+	m_worker_count = std::min<u32>(utils::get_thread_count() / 2, 3);
+}
+
+io_thread_pool::~io_thread_pool()
+{
+	// Abort and join the workers before the job state is destroyed
+	m_workers.reset();
+}
+
+void io_thread_pool::process_chunks(job_t& job) const
+{
+	for (u32 index = job.next++; index < job.count; index = job.next++)
+	{
+		(*job.func)(index);
+
+		if (job.done.add_fetch(1) == job.count)
+		{
+			job.done.notify_one();
+		}
+	}
+}
+
+bool io_thread_pool::try_run(u32 count, const chunk_func& func)
+{
+	if (!m_worker_count || count < 2)
+	{
+		return false;
+	}
+
+	std::unique_lock submit_lock(m_submit_mutex, std::try_to_lock);
+
+	if (!submit_lock)
+	{
+		return false;
+	}
+
+	if (!m_workers)
+	{
+		m_workers = std::make_unique<named_thread_group<worker_func>>("I/O Worker ", m_worker_count, worker_func{this});
+	}
+
+	job_t job{&func, count};
+
+	{
+		std::lock_guard lock(m_job_mutex);
+		m_job = &job;
+	}
+
+	m_job_seq++;
+	m_job_seq.notify_all();
+
+	process_chunks(job);
+
+	for (u32 done = job.done; done < count; done = job.done)
+	{
+		job.done.wait(done);
+	}
+
+	// Waits for the workers to leave the job
+	std::lock_guard lock(m_job_mutex);
+	m_job = nullptr;
+	return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/atomic.hpp"
+#include "Utilities/mutex.h"
+
+#include <functional>
+#include <memory>
+
+template <class Context>
+class named_thread_group;
+
+// Persistent host threads used to split large file transfers and decryption into chunks.
+// The submitting thread processes chunks as well and returns once all of them are done.
+// Workers are started on first use, most titles never issue transfers large enough.
+class io_thread_pool
+{
+public:
+	// Receives the index of a chunk in [0, count)
+	using chunk_func = std::function<void(u32 index)>;
+
+private:
+	struct job_t
+	{
+		const chunk_func* func;
+		u32 count;
+		atomic_t<u32> next = 0;
+		atomic_t<u32> done = 0;
+	};
+
+	struct worker_func
+	{
+		io_thread_pool* pool;
+
+		void operator()() const;
+	};
+
+	shared_mutex m_submit_mutex;
+
+	// Held shared by workers while they access m_job
+	shared_mutex m_job_mutex;
+	job_t* m_job = nullptr;
+	atomic_t<u32> m_job_seq = 0;
+
+	u32 m_worker_count = 0;
+
+	// Must be destroyed first
+	std::unique_ptr<named_thread_group<worker_func>> m_workers;
+
+	void process_chunks(job_t& job) const;
+
+public:
+	io_thread_pool();
+
+	io_thread_pool(const io_thread_pool&) = delete;
+
+	io_thread_pool& operator=(const io_thread_pool&) = delete;
+
+	~io_thread_pool();
+
+	// Run func over count chunks.
+	// Returns false without calling func if there are less than two chunks, no workers exist or the pool is busy.
+	bool try_run(u32 count, const chunk_func& func);
+};
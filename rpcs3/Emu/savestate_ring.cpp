@@ -0,0 +1,390 @@
+#include "stdafx.h"
+#include "savestate_ring.hpp"
+
+#include "Emu/CPU/CPUThread.h"
+#include "Emu/Cell/timers.hpp"
+#include "Emu/Memory/vm.h"
+#include "util/serialization.hpp"
+#include "util/asm.hpp"
+
+#include <span>
+#include <zstd.h>
+
+LOG_CHANNEL(sys_log, "SYS");
+
+// Negative zstd levels trade ratio for speed close to LZ4, snapshots are short-lived
+constexpr int s_ring_compression_level = -3;
+
+savestate_ring::savestate_ring(usz max_snapshots, usz key_interval)
+	: m_max_snapshots(std::max<usz>(max_snapshots, 1))
+	, m_key_interval(std::max<usz>(key_interval, 1))
+{
+	m_worker = std::make_unique<named_thread<std::function<void()>>>("Savestate Ring Thread"sv, [this]() { compress_thread_op(); });
+}
+
+savestate_ring::~savestate_ring()
+{
+	// Join the worker before destroying the snapshots
+	m_worker.reset();
+}
+
+savestate_ring::snapshot* savestate_ring::find(u64 id)
+{
+	// IDs are contiguous, only the oldest snapshots are removed
+	if (m_snapshots.empty() || id < m_snapshots.front().id || id - m_snapshots.front().id >= m_snapshots.size())
+	{
+		return nullptr;
+	}
+
+	return &m_snapshots[id - m_snapshots.front().id];
+}
+
+savestate_ring::capture_data savestate_ring::begin_capture()
+{
+	capture_data capture{};
+
+	if (!m_pool.empty())
+	{
+		capture.data = std::move(m_pool.back());
+		capture.data.clear();
+		m_pool.pop_back();
+	}
+
+	capture.is_key = m_hashes.empty() || m_since_key >= m_key_interval;
+	return capture;
+}
+
+void savestate_ring::encode(capture_data& capture, const std::vector<memory_region>& regions) const
+{
+	utils::serial ar;
+	ar.data = std::move(capture.data);
+
+	ar(regions.size());
+
+	for (const auto& [addr, ptr, size] : regions)
+	{
+		const usz page_count = size / 4096;
+
+		const auto old = m_hashes.find(addr);
+		const bool is_new = old == m_hashes.end() || old->second.size() != page_count;
+
+		auto& new_hashes = capture.hashes[addr];
+		new_hashes.resize(page_count);
+
+		// Bitmap of stored pages followed by their contents
+		std::vector<u8> bit_array(utils::aligned_div<usz>(page_count, 8));
+
+		for (usz i = 0; i < page_count; i++)
+		{
+			new_hashes[i] = vm::hash_memory_page(ptr + i * 4096);
+
+			const bool changed = is_new || old->second[i] != new_hashes[i];
+
+			if (changed)
+			{
+				capture.modified.push_back(static_cast<u32>(addr + i * 4096));
+			}
+
+			if (changed || capture.is_key)
+			{
+				bit_array[i / 8] |= 1u << (i % 8);
+			}
+		}
+
+		ar(addr, size);
+		ar(std::span<u8>(bit_array.data(), bit_array.size()));
+
+		for (usz i = 0; i < page_count; i++)
+		{
+			if (bit_array[i / 8] & (1u << (i % 8)))
+			{
+				ar(std::span<u8>(ptr + i * 4096, 4096));
+			}
+		}
+	}
+
+	capture.data = std::move(ar.data);
+}
+
+u64 savestate_ring::end_capture(capture_data&& capture)
+{
+	m_hashes = std::move(capture.hashes);
+	m_since_key = capture.is_key ? 1 : m_since_key + 1;
+
+	auto& snap = m_snapshots.emplace_back();
+	snap.id = m_next_id++;
+	snap.time = get_system_time();
+	snap.is_key = capture.is_key;
+	snap.raw_size = capture.data.size();
+	snap.raw = std::make_shared<std::vector<u8>>(std::move(capture.data));
+	snap.modified = std::move(capture.modified);
+
+	const u64 id = snap.id;
+
+	// Remove the oldest key snapshot with its deltas, unless it is the group being recorded
+	while (m_snapshots.size() > m_max_snapshots)
+	{
+		const auto next_key = std::find_if(m_snapshots.begin() + 1, m_snapshots.end(), [](const snapshot& s) { return s.is_key; });
+
+		if (next_key == m_snapshots.end())
+		{
+			break;
+		}
+
+		m_snapshots.erase(m_snapshots.begin(), next_key);
+	}
+
+	m_queue.push(id);
+	return id;
+}
+
+u64 savestate_ring::capture()
+{
+	std::lock_guard lock(m_mutex);
+
+	capture_data capture = begin_capture();
+
+	cpu_thread::suspend_all(nullptr, {}, [&]()
+	{
+		encode(capture, vm::get_saved_memory_regions());
+	});
+
+	return end_capture(std::move(capture));
+}
+
+u64 savestate_ring::capture(const std::vector<memory_region>& regions)
+{
+	std::lock_guard lock(m_mutex);
+
+	capture_data capture = begin_capture();
+	encode(capture, regions);
+	return end_capture(std::move(capture));
+}
+
+bool savestate_ring::decode_chain(u64 id, std::vector<std::vector<u8>>& chain)
+{
+	if (!find(id))
+	{
+		return false;
+	}
+
+	const usz index = id - m_snapshots.front().id;
+	usz first = index;
+
+	while (!m_snapshots[first].is_key)
+	{
+		first--;
+	}
+
+	for (usz i = first; i <= index; i++)
+	{
+		auto& snap = m_snapshots[i];
+
+		if (snap.raw)
+		{
+			// Not compressed yet
+			chain.emplace_back(*snap.raw);
+			continue;
+		}
+
+		std::vector<u8> data(snap.raw_size);
+		const usz size = ZSTD_decompress(data.data(), data.size(), snap.compressed.data(), snap.compressed.size());
+
+		if (ZSTD_isError(size) || size != snap.raw_size)
+		{
+			sys_log.error("Failed to decompress snapshot %u of savestate ring (%s)", snap.id, ZSTD_isError(size) ? ZSTD_getErrorName(size) : "size mismatch");
+			return false;
+		}
+
+		chain.emplace_back(std::move(data));
+	}
+
+	return true;
+}
+
+usz savestate_ring::apply_chain(std::vector<std::vector<u8>>& chain, const std::vector<memory_region>& regions)
+{
+	std::unordered_map<u32, std::pair<u8*, usz>> region_map;
+
+	for (const auto& [addr, ptr, size] : regions)
+	{
+		region_map.emplace(addr, std::make_pair(ptr, size));
+	}
+
+	usz skipped = 0;
+
+	for (auto& data : chain)
+	{
+		utils::serial ar;
+		ar.set_reading_state(std::move(data));
+
+		const usz count = ar.pop<usz>();
+
+		for (usz region = 0; region < count; region++)
+		{
+			const u32 addr = ar.pop<u32>();
+			const usz size = ar.pop<usz>();
+			const usz page_count = size / 4096;
+
+			const auto found = region_map.find(addr);
+			u8* const ptr = found != region_map.end() && found->second.second == size ? found->second.first : nullptr;
+
+			std::vector<u8> bit_array(utils::aligned_div<usz>(page_count, 8));
+			ar(std::span<u8>(bit_array.data(), bit_array.size()));
+
+			if (!ptr)
+			{
+				skipped++;
+			}
+
+			for (usz i = 0; i < page_count; i++)
+			{
+				if (!(bit_array[i / 8] & (1u << (i % 8))))
+				{
+					continue;
+				}
+
+				if (ptr)
+				{
+					ar(std::span<u8>(ptr + i * 4096, 4096));
+				}
+				else
+				{
+					ar.pos += 4096;
+				}
+			}
+		}
+	}
+
+	return skipped;
+}
+
+bool savestate_ring::restore(u64 id)
+{
+	std::lock_guard lock(m_mutex);
+
+	// Decode the chain from the key snapshot before touching memory
+	std::vector<std::vector<u8>> chain;
+
+	if (!decode_chain(id, chain))
+	{
+		return false;
+	}
+
+	const usz chain_size = chain.size();
+	usz skipped = 0;
+
+	cpu_thread::suspend_all(nullptr, {}, [&]()
+	{
+		skipped = apply_chain(chain, vm::get_saved_memory_regions());
+	});
+
+	// Memory no longer matches the last snapshot, start a new group
+	m_hashes.clear();
+
+	sys_log.success("Restored snapshot %u of savestate ring (chain=%u, skipped regions=%u)", id, chain_size, skipped);
+	return true;
+}
+
+bool savestate_ring::restore(u64 id, const std::vector<memory_region>& regions)
+{
+	std::lock_guard lock(m_mutex);
+
+	std::vector<std::vector<u8>> chain;
+
+	if (!decode_chain(id, chain))
+	{
+		return false;
+	}
+
+	apply_chain(chain, regions);
+	m_hashes.clear();
+	return true;
+}
+
+std::vector<u32> savestate_ring::get_modified_pages(u64 from_id, u64 to_id)
+{
+	std::lock_guard lock(m_mutex);
+
+	std::vector<u32> result;
+
+	for (u64 id = std::min(from_id, to_id) + 1; id <= std::max(from_id, to_id); id++)
+	{
+		if (const snapshot* snap = find(id))
+		{
+			result.insert(result.end(), snap->modified.begin(), snap->modified.end());
+		}
+	}
+
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return result;
+}
+
+std::vector<savestate_ring::snapshot_info> savestate_ring::get_snapshots()
+{
+	reader_lock lock(m_mutex);
+
+	std::vector<snapshot_info> result;
+	result.reserve(m_snapshots.size());
+
+	for (const auto& snap : m_snapshots)
+	{
+		result.push_back(snapshot_info{snap.id, snap.time, snap.is_key, snap.raw_size, snap.compressed.size()});
+	}
+
+	return result;
+}
+
+void savestate_ring::compress_thread_op()
+{
+	ZSTD_CCtx* zc = ZSTD_createCCtx();
+
+	std::vector<u8> stream_data;
+
+	while (thread_ctrl::state() != thread_state::aborting)
+	{
+		for (u64 id : m_queue.pop_all())
+		{
+			std::shared_ptr<std::vector<u8>> raw;
+
+			{
+				reader_lock lock(m_mutex);
+
+				if (snapshot* snap = find(id))
+				{
+					raw = snap->raw;
+				}
+			}
+
+			if (!raw)
+			{
+				// Removed meanwhile
+				continue;
+			}
+
+			stream_data.resize(::ZSTD_compressBound(raw->size()));
+			const usz out_size = ZSTD_compressCCtx(zc, stream_data.data(), stream_data.size(), raw->data(), raw->size(), s_ring_compression_level);
+
+			ensure(!ZSTD_isError(out_size) && out_size);
+
+			std::lock_guard lock(m_mutex);
+
+			if (snapshot* snap = find(id))
+			{
+				snap->compressed.assign(stream_data.data(), stream_data.data() + out_size);
+				snap->raw.reset();
+			}
+
+			// Reuse the buffer
+			if (raw.use_count() == 1 && m_pool.size() < 4)
+			{
+				m_pool.emplace_back(std::move(*raw));
+			}
+		}
+
+		thread_ctrl::wait_on(m_queue);
+	}
+
+	ZSTD_freeCCtx(zc);
+}
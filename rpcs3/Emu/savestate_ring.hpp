@@ -0,0 +1,104 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "Utilities/mutex.h"
+#include "Utilities/lockless.h"
+#include "Utilities/Thread.h"
+
+#include <deque>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// In-memory ring of guest memory snapshots for rewind and A/B comparison of emulation runs
+// A snapshot stores the pages modified since the previous one, every key_interval snapshots a full one is stored
+// Snapshots are serialized with utils::serial and compressed by a background thread with a fast zstd level
+// Only guest memory is captured: thread contexts and HLE state are not part of snapshots
+class savestate_ring
+{
+public:
+	struct snapshot_info
+	{
+		u64 id;
+		u64 time; // get_system_time() at capture
+		bool is_key;
+		usz raw_size;
+		usz compressed_size; // 0 while compressing
+	};
+
+	// Address, pointer and size (multiple of 4096)
+	using memory_region = std::tuple<u32, u8*, usz>;
+
+	explicit savestate_ring(usz max_snapshots = 64, usz key_interval = 16);
+
+	savestate_ring(const savestate_ring&) = delete;
+	savestate_ring& operator=(const savestate_ring&) = delete;
+
+	~savestate_ring();
+
+	// Capture guest memory (CPU threads are suspended meanwhile, do not call from a CPU thread), returns the snapshot ID
+	u64 capture();
+
+	// Restore guest memory of a snapshot, regions which are no longer mapped are skipped
+	bool restore(u64 id);
+
+	// Capture or restore the given regions instead of guest memory, the caller must keep them from being accessed meanwhile
+	u64 capture(const std::vector<memory_region>& regions);
+	bool restore(u64 id, const std::vector<memory_region>& regions);
+
+	// Addresses of pages modified between two snapshots, sorted
+	std::vector<u32> get_modified_pages(u64 from_id, u64 to_id);
+
+	std::vector<snapshot_info> get_snapshots();
+
+private:
+	struct snapshot
+	{
+		u64 id;
+		u64 time;
+		bool is_key;
+		usz raw_size;
+		std::shared_ptr<std::vector<u8>> raw; // Released when compressed
+		std::vector<u8> compressed;
+		std::vector<u32> modified; // Pages modified since the previous snapshot
+	};
+
+	const usz m_max_snapshots;
+	const usz m_key_interval;
+
+	shared_mutex m_mutex;
+	std::deque<snapshot> m_snapshots;
+	u64 m_next_id = 1;
+	usz m_since_key = 0;
+
+	// Page hashes of the last snapshot by region address
+	std::unordered_map<u32, std::vector<u64>> m_hashes;
+
+	// Serialization buffers for reuse
+	std::vector<std::vector<u8>> m_pool;
+
+	lf_queue<u64> m_queue;
+	std::unique_ptr<named_thread<std::function<void()>>> m_worker;
+
+	struct capture_data
+	{
+		std::vector<u8> data;
+		bool is_key;
+		std::unordered_map<u32, std::vector<u64>> hashes;
+		std::vector<u32> modified;
+	};
+
+	snapshot* find(u64 id);
+
+	// Capture steps, called with m_mutex locked
+	capture_data begin_capture();
+	void encode(capture_data& capture, const std::vector<memory_region>& regions) const;
+	u64 end_capture(capture_data&& capture);
+
+	// Restore steps, decode_chain is called with m_mutex locked and apply_chain returns the number of skipped regions
+	bool decode_chain(u64 id, std::vector<std::vector<u8>>& chain);
+	static usz apply_chain(std::vector<std::vector<u8>>& chain, const std::vector<memory_region>& regions);
+
+	void compress_thread_op();
+};
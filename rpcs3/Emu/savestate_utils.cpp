@@ -40,7 +40,7 @@ static std::array<serial_ver_t, 27> s_serial_versions;
 		return ::s_serial_versions[identifier].current_version;\
 	}
 
-SERIALIZATION_VER(global_version, 0,                            19) // For stuff not listed here
+SERIALIZATION_VER(global_version, 0,                            19, 20/*Incremental memory*/) // For stuff not listed here
 SERIALIZATION_VER(ppu, 1,                                       1, 2/*PPU sleep order*/, 3/*PPU FNID and module*/)
 SERIALIZATION_VER(spu, 2,                                       1)
 SERIALIZATION_VER(lv2_sync, 3,                                  1)
@@ -507,10 +507,61 @@ bool boot_current_game_savestate(bool testing, u32 index)
 	return false;
 }
 
+// File name of the base of incremental savestates which the savestate refers to, read from its header
+static std::string get_savestate_base_name(const std::string& path)
+{
+	const auto ar = make_savestate_reader(path);
+
+	if (!ar)
+	{
+		return {};
+	}
+
+	const auto header = ar->try_read<savestate_header>().second;
+
+	if (header.magic != "RPCS3SAV"_u64 || !header.flag_versions_is_following_data || header.offset != ar->pos)
+	{
+		return {};
+	}
+
+	const auto versions = ar->pop<std::vector<version_entry>>();
+
+	if (std::none_of(versions.begin(), versions.end(), [](const version_entry& e) { return e.type == 0 && e.version >= 20; }) || !ar->pop<b8>())
+	{
+		return {};
+	}
+
+	for (u32 i = 0; i < 4; i++)
+	{
+		// Build version, creation time, title, user note
+		ar->pop<std::string>();
+	}
+
+	return ar->pop<std::string>();
+}
+
 void clean_savestates(std::string_view title_id, std::string_view boot_path, usz max_files, usz max_files_size)
 {
 	ensure(max_files && max_files != umax);
 
+	const std::string dir_path = get_savestate_file(title_id, boot_path, -1, umax);
+
+	// Bases of incremental savestates count towards the space limit
+	usz bases_size = 0;
+
+	for (auto&& dir_entry : fs::dir(dir_path))
+	{
+		if (!dir_entry.is_directory && dir_entry.name.ends_with(".base.zst"))
+		{
+			bases_size += dir_entry.size;
+		}
+	}
+
+	if (max_files_size)
+	{
+		max_files_size = std::max<usz>(max_files_size - std::min(bases_size, max_files_size), 1);
+	}
+
 	bool logged_limits = false;
 
 	while (true)
@@ -541,6 +592,49 @@ void clean_savestates(std::string_view title_id, std::string_view boot_path, usz
 			}
 		}
 	}
+
+	if (!bases_size)
+	{
+		return;
+	}
+
+	// Remove bases which no savestate refers to
+	std::set<std::string> bases_in_use;
+	std::vector<std::string> bases;
+
+	for (auto&& dir_entry : fs::dir(dir_path))
+	{
+		if (dir_entry.is_directory)
+		{
+			continue;
+		}
+
+		if (dir_entry.name.ends_with(".base.zst"))
+		{
+			bases.push_back(dir_entry.name);
+		}
+		else if (dir_entry.name.ends_with(".SAVESTAT.zst") || dir_entry.name.ends_with(".SAVESTAT.gz") || dir_entry.name.ends_with(".SAVESTAT"))
+		{
+			bases_in_use.emplace(get_savestate_base_name(dir_path + dir_entry.name));
+		}
+	}
+
+	for (const std::string& base : bases)
+	{
+		if (bases_in_use.count(base))
+		{
+			continue;
+		}
+
+		if (fs::remove_file(dir_path + base))
+		{
+			sys_log.success("Removed unused base of incremental savestates at '%s'.", dir_path + base);
+		}
+		else
+		{
+			sys_log.error("Failed to remove base of incremental savestates at '%s'! (error: %s)", dir_path + base, fs::g_tls_error);
+		}
+	}
 }
 
 bool load_and_check_reserved(utils::serial& ar, usz size)
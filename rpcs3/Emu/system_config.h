@@ -22,6 +22,7 @@ struct cfg_root : cfg::node
 		cfg::string llvm_cpu{ this, "Use LLVM CPU" };
 		cfg::_int<0, 1024> llvm_threads{ this, "Max LLVM Compile Threads", 0 };
 		cfg::_bool ppu_llvm_greedy_mode{ this, "PPU LLVM Greedy Mode", false, false };
+		cfg::_bool ppu_llvm_object_bundle{ this, "PPU LLVM Object Bundle", false }; // Store new PPU objects zstd compressed in one file shared by all titles
 		cfg::_bool llvm_precompilation{ this, "LLVM Precompilation", true };
 		cfg::_enum<thread_scheduler_mode> thread_scheduler{this, "Thread Scheduler Mode", thread_scheduler_mode::os};
 		cfg::_bool set_daz_and_ftz{ this, "Set DAZ and FTZ", false };
@@ -77,8 +78,10 @@ struct cfg_root : cfg::node
 		cfg::_bool hook_functions{ this, "Hook static functions" };
 		cfg::set_entry libraries_control{ this, "Libraries Control" }; // Override HLE/LLE behaviour of selected libs
 		cfg::_bool hle_lwmutex{ this, "HLE lwmutex" }; // Force alternative lwmutex/lwcond implementation
+		cfg::uint<0, 16> vdec_threads{ this, "Video Decoder Threads", 0 }; // Slice threads of cellVdec decoders, 0 = auto
 		cfg::uint64 spu_llvm_lower_bound{ this, "SPU LLVM Lower Bound" };
 		cfg::uint64 spu_llvm_upper_bound{ this, "SPU LLVM Upper Bound", 0xffffffffffffffff };
+		cfg::uint<0, 1000000> spu_llvm_promotion_threshold{ this, "SPU LLVM Promotion Threshold", 0 }; // Executions of a block before LLVM compilation, 0 = compile every block
 
 		cfg::_int<10, 3000> clocks_scale{ this, "Clocks scale", 100 }; // Changing this from 100 (percentage) may affect game speed in unexpected ways
 		cfg::uint<0, 3000> spu_wakeup_delay{ this, "SPU Wake-Up Delay", 0, true };
@@ -335,6 +338,7 @@ struct cfg_root : cfg::node
 		cfg::_bool compatible_mode{ this, "Compatible Savestate Mode", false }; // SPU emulation optimized for savestate compatibility (off by default for performance reasons)
 		cfg::_bool state_inspection_mode{ this, "Inspection Mode Savestates" }; // Save memory stored in executable files, thus allowing to view state without any files (for debugging)
 		cfg::_bool save_disc_game_data{ this, "Save Disc Game Data", false };
+		cfg::_bool incremental{ this, "Incremental Savestates", false }; // Store only memory pages changed since a full savestate kept as the base
 		cfg::uint<0, 64> max_files{ this, "Maximum SaveState Files", 4 };
 		cfg::uint<0, 1024 * 512> max_files_size{ this, "Maximum SaveState Files Space (MiB)", 4096 };
 	} savestate{this};
@@ -2,15 +2,25 @@
 
 #include "ISO.h"
 #include "Emu/VFS.h"
+#include "Utilities/Thread.h"
 
 #include <codecvt>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <filesystem>
-#include <stack>
 
 LOG_CHANNEL(sys_log, "SYS");
 
+// Memory budget of the block cache of each archive
+constexpr u64 iso_cache_size = 16 * 1024 * 1024;
+
+// Reads of this size and above go straight to the image
+constexpr u64 iso_cache_bypass_size = 256 * 1024;
+
+// Data loaded ahead of sequential reads
+constexpr u64 iso_read_ahead_size = 512 * 1024;
+
 bool is_file_iso(const std::string& path)
 {
 	if (path.empty()) return false;
@@ -220,6 +230,7 @@ iso_archive::iso_archive(const std::string& path)
 {
 	m_path = path;
 	m_file = fs::file(path);
+	m_cache = std::make_shared<iso_sector_cache>(fs::file(path), iso_cache_size);
 
 	if (!is_file_iso(m_file))
 	{
@@ -255,6 +266,27 @@ iso_archive::iso_archive(const std::string& path)
 	while (descriptor_type != 255);
 
 	iso_form_hierarchy(m_file, m_root, use_ucs2_decoding);
+	index_hierarchy(m_root, "");
+}
+
+void iso_archive::index_hierarchy(iso_fs_node& node, const std::string& parent_path)
+{
+	for (auto& child_node : node.children)
+	{
+		const std::string& name = child_node->metadata.name;
+
+		if (name == "." || name == "..")
+		{
+			continue;
+		}
+
+		const std::string path = parent_path.empty() ? name : parent_path + "/" + name;
+
+		// Keep the first entry of duplicated names, like the directory walk did
+		m_path_index.try_emplace(path, child_node.get());
+
+		index_hierarchy(*child_node, path);
+	}
 }
 
 iso_fs_node* iso_archive::retrieve(const std::string& passed_path)
@@ -264,59 +296,57 @@ iso_fs_node* iso_archive::retrieve(const std::string& passed_path)
 	const std::string path = std::filesystem::path(passed_path).string();
 	const std::string_view path_sv = path;
 
-	size_t start = 0;
-	size_t end = path_sv.find_first_of(fs::delim);
-
-	std::stack<iso_fs_node*> search_stack;
-	search_stack.push(&m_root);
+	// Resolve "." and ".." lexically, then look the full path up
+	std::vector<std::string_view> components;
 
-	do
+	for (usz start = 0; start < path.size();)
 	{
-		if (search_stack.empty()) return nullptr;
-		const auto* top_entry = search_stack.top();
+		usz end = path_sv.find_first_of(fs::delim, start);
 
 		if (end == umax)
 		{
 			end = path.size();
 		}
 
-		const std::string_view path_component = path_sv.substr(start, end-start);
-
-		bool found = false;
+		const std::string_view path_component = path_sv.substr(start, end - start);
 
-		if (path_component == ".")
+		if (path_component == "..")
 		{
-			found = true;
+			if (components.empty()) return nullptr;
+
+			components.pop_back();
 		}
-		else if (path_component == "..")
+		else if (path_component.empty())
 		{
-			search_stack.pop();
-			found = true;
+			return nullptr;
 		}
-		else
+		else if (path_component != ".")
 		{
-			for (const auto& entry : top_entry->children)
-			{
-				if (entry->metadata.name == path_component)
-				{
-					search_stack.push(entry.get());
-
-					found = true;
-					break;
-				}
-			}
+			components.push_back(path_component);
 		}
 
-		if (!found) return nullptr;
-
 		start = end + 1;
-		end = path_sv.find_first_of(fs::delim, start);
 	}
-	while (start < path.size());
 
-	if (search_stack.empty()) return nullptr;
+	if (components.empty()) return &m_root;
 
-	return search_stack.top();
+	std::string key;
+
+	for (const std::string_view& component : components)
+	{
+		if (!key.empty())
+		{
+			key += '/';
+		}
+
+		key += component;
+	}
+
+	const auto found = m_path_index.find(key);
+
+	if (found == m_path_index.end()) return nullptr;
+
+	return found->second;
 }
 
 bool iso_archive::exists(const std::string& path)
@@ -334,7 +364,7 @@ bool iso_archive::is_file(const std::string& path)
 
 iso_file iso_archive::open(const std::string& path)
 {
-	return iso_file(fs::file(m_path), *ensure(retrieve(path)));
+	return iso_file(m_cache, *ensure(retrieve(path)));
 }
 
 psf::registry iso_archive::open_psf(const std::string& path)
@@ -342,7 +372,7 @@ psf::registry iso_archive::open_psf(const std::string& path)
 	auto* archive_file = retrieve(path);
 	if (!archive_file) return psf::registry();
 
-	const fs::file psf_file(std::make_unique<iso_file>(fs::file(m_path), *archive_file));
+	const fs::file psf_file(std::make_unique<iso_file>(m_cache, *archive_file));
 
 	return psf::load_object(psf_file, path);
 }
@@ -353,6 +383,12 @@ iso_file::iso_file(fs::file&& iso_handle, const iso_fs_node& node)
 	m_file.seek(ISO_BLOCK_SIZE * node.metadata.extents[0].start);
 }
 
+iso_file::iso_file(std::shared_ptr<iso_sector_cache> cache, const iso_fs_node& node)
+	: m_cache(std::move(cache)), m_meta(node.metadata)
+{
+	ensure(m_cache);
+}
+
 fs::stat_t iso_file::get_stat()
 {
 	return fs::stat_t
@@ -418,19 +454,54 @@ u64 iso_file::read(void* buffer, u64 size)
 
 u64 iso_file::read_at(u64 offset, void* buffer, u64 size)
 {
-	const u64 local_remaining = local_extent_remaining(offset);
+	const u64 total_size = this->size();
+
+	if (offset >= total_size)
+	{
+		m_next_pos = u64{umax};
+		return 0;
+	}
 
-	const u64 total_read = m_file.read_at(file_offset(offset), buffer, std::min(size, local_remaining));
+	size = std::min(size, total_size - offset);
 
-	const auto total_size = this->size();
+	u64 total_read = 0;
 
-	if (size > total_read && (offset + total_read) < total_size)
+	// Split at extent boundaries
+	while (total_read < size)
 	{
-		const u64 second_total_read = read_at(offset + total_read, reinterpret_cast<u8*>(buffer) + total_read, size - total_read);
+		const u64 pos = offset + total_read;
+		const u64 count = std::min(size - total_read, local_extent_remaining(pos));
+		u8* const dst = static_cast<u8*>(buffer) + total_read;
 
-		return total_read + second_total_read;
+		const u64 read = m_cache ? m_cache->read_at(file_offset(pos), dst, count) : m_file.read_at(file_offset(pos), dst, count);
+
+		total_read += read;
+
+		if (read < count)
+		{
+			break;
+		}
 	}
 
+	if (m_cache && offset == m_next_pos && total_read < iso_cache_bypass_size)
+	{
+		const u64 next = offset + total_read;
+
+		// Keep at least half a window queued ahead of the reader
+		if (next < total_size && next + iso_read_ahead_size / 2 > m_read_ahead_end)
+		{
+			const u64 count = std::min(iso_read_ahead_size, local_extent_remaining(next));
+
+			m_cache->read_ahead(file_offset(next), count);
+			m_read_ahead_end = next + count;
+		}
+	}
+	else if (offset != m_next_pos)
+	{
+		m_read_ahead_end = 0;
+	}
+
+	m_next_pos = offset + total_read;
 	return total_read;
 }
 
@@ -454,8 +525,11 @@ u64 iso_file::seek(s64 offset, fs::seek_mode whence)
 		return -1;
 	}
 
-	const u64 result = m_file.seek(file_offset(m_pos));
-	if (result == umax) return umax;
+	if (m_file)
+	{
+		const u64 result = m_file.seek(file_offset(m_pos));
+		if (result == umax) return umax;
+	}
 
 	m_pos = new_pos;
 	return m_pos;
@@ -475,6 +549,155 @@ u64 iso_file::size()
 void iso_file::release()
 {
 	m_file.release();
+	m_cache.reset();
+}
+
+iso_sector_cache::iso_sector_cache(fs::file&& image, u64 capacity)
+	: m_file(std::move(image))
+	, m_image_size(m_file ? m_file.size() : 0)
+	, m_capacity(std::max<u64>(capacity / block_size, 1))
+{
+}
+
+std::shared_ptr<const iso_sector_cache::cached_block> iso_sector_cache::find_block(u64 index)
+{
+	std::lock_guard lock(m_mutex);
+
+	const auto found = m_blocks.find(index);
+
+	if (found == m_blocks.end())
+	{
+		return nullptr;
+	}
+
+	found->second.last_use = ++m_use_counter;
+	return found->second.block;
+}
+
+std::shared_ptr<const iso_sector_cache::cached_block> iso_sector_cache::load_block(u64 index)
+{
+	auto block = std::make_shared<cached_block>();
+	block->data.resize(block_size);
+
+	if (m_file)
+	{
+		block->size = m_file.read_at(index * block_size, block->data.data(), block_size);
+	}
+
+	// Don't keep the result of a failed read, or an empty block past the end of the image
+	const u64 block_start = std::min(index * block_size, m_image_size);
+
+	if (!block->size || block->size != std::min(block_size, m_image_size - block_start))
+	{
+		return block;
+	}
+
+	std::lock_guard lock(m_mutex);
+
+	if (const auto found = m_blocks.find(index); found != m_blocks.end())
+	{
+		// Loaded by another reader in the meantime
+		found->second.last_use = ++m_use_counter;
+		return found->second.block;
+	}
+
+	if (m_blocks.size() >= m_capacity)
+	{
+		m_blocks.erase(std::min_element(m_blocks.begin(), m_blocks.end(), FN(x.second.last_use < y.second.last_use)));
+	}
+
+	m_blocks.emplace(index, cache_entry{block, ++m_use_counter});
+	return block;
+}
+
+u64 iso_sector_cache::read_at(u64 offset, void* buffer, u64 size)
+{
+	// Mostly whole file loads, which would only evict the working set
+	if (size >= iso_cache_bypass_size)
+	{
+		return m_file ? m_file.read_at(offset, buffer, size) : 0;
+	}
+
+	u64 total_read = 0;
+
+	while (total_read < size)
+	{
+		const u64 pos = offset + total_read;
+		const u64 block_offset = pos % block_size;
+
+		auto block = find_block(pos / block_size);
+
+		if (!block)
+		{
+			block = load_block(pos / block_size);
+		}
+
+		if (block->size <= block_offset)
+		{
+			break;
+		}
+
+		const u64 count = std::min(size - total_read, block->size - block_offset);
+		std::memcpy(static_cast<u8*>(buffer) + total_read, block->data.data() + block_offset, count);
+		total_read += count;
+	}
+
+	return total_read;
+}
+
+void iso_sector_cache::read_ahead_thread::operator()()
+{
+	for (u32 seq = cache->m_read_ahead_seq; thread_ctrl::state() != thread_state::aborting;)
+	{
+		thread_ctrl::wait_on(cache->m_read_ahead_seq, seq);
+		seq = cache->m_read_ahead_seq;
+
+		const u64 first = cache->m_read_ahead_block;
+		const u64 last = first + cache->m_read_ahead_count;
+
+		// Stop early when a newer request arrives
+		for (u64 i = first; i < last && seq == cache->m_read_ahead_seq && thread_ctrl::state() != thread_state::aborting; i++)
+		{
+			if (!cache->find_block(i) && cache->load_block(i)->size < block_size)
+			{
+				break;
+			}
+		}
+	}
+}
+
+void iso_sector_cache::read_ahead(u64 offset, u64 size)
+{
+	if (!size || offset >= m_image_size)
+	{
+		return;
+	}
+
+	const u64 first = offset / block_size;
+	const u64 last = (std::min(offset + size, m_image_size) - 1) / block_size;
+
+	// The window must stay well below the capacity so it doesn't evict data being read
+	const u64 count = std::min(last - first + 1, m_capacity / 2);
+
+	if (!count)
+	{
+		return;
+	}
+
+	{
+		// The thread is only started for archives that are actually streamed
+		std::lock_guard lock(m_mutex);
+
+		if (!m_read_ahead)
+		{
+			m_read_ahead = std::make_shared<named_thread<read_ahead_thread>>(read_ahead_thread{this});
+		}
+	}
+
+	m_read_ahead_block = first;
+	m_read_ahead_count = count;
+	m_read_ahead_seq++;
+	m_read_ahead_seq.notify_one();
 }
 
 bool iso_dir::read(fs::dir_entry& entry)
@@ -569,7 +792,7 @@ std::unique_ptr<fs::file_base> iso_device::open(const std::string& path, bs_t<fs
 		return nullptr;
 	}
 
-	return std::make_unique<iso_file>(fs::file(iso_path), *node);
+	return std::make_unique<iso_file>(m_archive.get_sector_cache(), *node);
 }
 
 std::unique_ptr<fs::dir_base> iso_device::open_dir(const std::string& path)
@@ -3,8 +3,15 @@
 #include "Loader/PSF.h"
 
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
 #include "util/types.hpp"
 
+#include <memory>
+#include <unordered_map>
+
+template <class Context>
+class named_thread;
+
 bool is_file_iso(const std::string& path);
 bool is_file_iso(const fs::file& path);
 
@@ -34,13 +41,75 @@ struct iso_fs_node
 	std::vector<std::unique_ptr<iso_fs_node>> children;
 };
 
+// Size-bounded LRU cache of image blocks, shared by every file opened from the same archive
+class iso_sector_cache
+{
+public:
+	// 32 sectors per block
+	static constexpr u64 block_size = 0x10000;
+
+private:
+	struct cached_block
+	{
+		u64 size = 0; // Valid bytes in data (shorter at the end of the image)
+		std::vector<u8> data;
+	};
+
+	struct cache_entry
+	{
+		std::shared_ptr<const cached_block> block;
+		u64 last_use = 0;
+	};
+
+	fs::file m_file;
+	u64 m_image_size = 0;
+
+	shared_mutex m_mutex;
+	std::unordered_map<u64, cache_entry> m_blocks;
+	u64 m_capacity = 0; // In blocks
+	u64 m_use_counter = 0;
+
+	atomic_t<u64> m_read_ahead_block = 0;
+	atomic_t<u64> m_read_ahead_count = 0;
+	atomic_t<u32> m_read_ahead_seq = 0;
+
+	struct read_ahead_thread
+	{
+		static constexpr std::string_view thread_name = "ISO Read-ahead";
+
+		iso_sector_cache* cache;
+
+		void operator()();
+	};
+
+	// Must be destroyed first
+	std::shared_ptr<named_thread<read_ahead_thread>> m_read_ahead;
+
+	std::shared_ptr<const cached_block> find_block(u64 index);
+	std::shared_ptr<const cached_block> load_block(u64 index);
+
+public:
+	iso_sector_cache(fs::file&& image, u64 capacity);
+
+	// Read at an absolute image offset
+	u64 read_at(u64 offset, void* buffer, u64 size);
+
+	// Queue an image range for asynchronous loading, replacing the previous request
+	void read_ahead(u64 offset, u64 size);
+};
+
 class iso_file : public fs::file_base
 {
 private:
 	fs::file m_file;
+	std::shared_ptr<iso_sector_cache> m_cache;
 	iso_fs_metadata m_meta {};
 	u64 m_pos = 0;
 
+	// Sequential access detection, atomic since positional reads may be issued concurrently
+	atomic_t<u64> m_next_pos = umax; // End of the previous read
+	atomic_t<u64> m_read_ahead_end = 0; // End of the last read-ahead request
+
 	std::pair<u64, iso_extent_info> get_extent_pos(u64 pos) const;
 	u64 file_offset(u64 pos) const;
 	u64 local_extent_remaining(u64 pos) const;
@@ -48,6 +117,7 @@ private:
 
 public:
 	iso_file(fs::file&& iso_handle, const iso_fs_node& node);
+	iso_file(std::shared_ptr<iso_sector_cache> cache, const iso_fs_node& node);
 
 	fs::stat_t get_stat() override;
 	bool trunc(u64 length) override;
@@ -82,6 +152,12 @@ private:
 	std::string m_path;
 	iso_fs_node m_root {};
 	fs::file m_file;
+	std::shared_ptr<iso_sector_cache> m_cache;
+
+	// Full path of every node except the root
+	std::unordered_map<std::string, iso_fs_node*> m_path_index;
+
+	void index_hierarchy(iso_fs_node& node, const std::string& parent_path);
 
 public:
 	iso_archive(const std::string& path);
@@ -93,6 +169,8 @@ public:
 	iso_file open(const std::string& path);
 
 	psf::registry open_psf(const std::string& path);
+
+	const std::shared_ptr<iso_sector_cache>& get_sector_cache() const { return m_cache; }
 };
 
 class iso_device : public fs::device_base
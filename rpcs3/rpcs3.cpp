@@ -388,6 +388,7 @@ constexpr auto arg_rsx_capture  = "rsx-capture";
 constexpr auto arg_timer        = "high-res-timer";
 constexpr auto arg_verbose_curl = "verbose-curl";
 constexpr auto arg_any_location = "allow-any-location";
+constexpr auto arg_deferred_log = "deferred-log";
 constexpr auto arg_codecs       = "codecs";
 
 #ifdef _WIN32
@@ -814,6 +815,7 @@ int run_rpcs3(int argc, char** argv)
 	parser.addOption(QCommandLineOption(arg_timer, "Enable high resolution timer for better performance (windows)", "enabled", "1"));
 	parser.addOption(QCommandLineOption(arg_verbose_curl, "Enable verbose curl logging."));
 	parser.addOption(QCommandLineOption(arg_any_location, "Allow RPCS3 to be run from any location. Dangerous"));
+	parser.addOption(QCommandLineOption(arg_deferred_log, "Format verbose log messages on the log writer thread."));
 	const QCommandLineOption codec_option(arg_codecs, "List ffmpeg codecs");
 	parser.addOption(codec_option);
 
@@ -863,6 +865,11 @@ int run_rpcs3(int argc, char** argv)
 	}
 #endif
 
+	if (parser.isSet(arg_deferred_log))
+	{
+		logs::set_deferred(true);
+	}
+
 	// Set curl to verbose if needed
 	rpcs3::curl::g_curl_verbose = parser.isSet(arg_verbose_curl);
 
@@ -14,6 +14,7 @@
 
 #include "Emu/System.h"
 #include "Emu/IdManager.h"
+#include "Emu/savestate_ring.hpp"
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/RSX/RSXDisAsm.h"
 #include "Emu/Cell/PPUAnalyser.h"
@@ -40,6 +41,8 @@
 #include "rpcs3qt/debugger_add_bp_window.h"
 #include "util/asm.hpp"
 
+LOG_CHANNEL(gui_log, "GUI");
+
 constexpr auto s_pause_flags = cpu_flag::dbg_pause + cpu_flag::dbg_global_pause;
 
 extern atomic_t<bool> g_debugger_pause_all_threads_on_bp;
@@ -325,6 +328,8 @@ void debugger_frame::keyPressEvent(QKeyEvent* event)
 			"\nKeys Alt+S: Launch a memory viewer pointed to the current RSX semaphores location when used from RSX."
 			"\nKeys Alt+R: Load last saved SPU state capture."
 			"\nKeys Alt+F5: Show the SPU disassmebler dialog."
+			"\nKeys Alt+A: Capture a snapshot of guest memory and log the pages modified since the previous one, emulation must be paused."
+			"\nKeys Alt+Z: Restore guest memory of the last snapshot (thread registers are not restored), emulation must be paused."
 			"\nKey D: SPU MFC commands logger, MFC debug setting must be enabled."
 			"\nKey D: Also PPU calling history logger, interpreter and non-zero call history size must be used."
 			"\nKey E: Instruction Editor: click on the instruction you want to modify, then press E."
@@ -718,6 +723,74 @@ void debugger_frame::keyPressEvent(QKeyEvent* event)
 
 			break;
 		}
+		case Qt::Key_A:
+		case Qt::Key_Z:
+		{
+			if (event->isAutoRepeat() || !(modifiers & Qt::AltModifier))
+			{
+				break;
+			}
+
+			if (!Emu.IsPaused())
+			{
+				QMessageBox::warning(this, tr("Pause the emulation!"), tr("Guest memory snapshots can only be captured or restored while the emulation is paused."));
+				return;
+			}
+
+			const u64 emulation_id = static_cast<std::underlying_type_t<Emulator::stop_counter_t>>(Emu.GetEmulationIdentifier());
+
+			if (!m_mem_snapshots || m_mem_snapshots_emulation_id != emulation_id)
+			{
+				// Snapshots of a previous emulation do not apply
+				m_mem_snapshots = std::make_shared<savestate_ring>();
+				m_mem_snapshots_emulation_id = emulation_id;
+			}
+
+			const auto snapshots = m_mem_snapshots->get_snapshots();
+
+			if (event->key() == Qt::Key_A)
+			{
+				const u64 id = m_mem_snapshots->capture();
+
+				if (snapshots.empty())
+				{
+					gui_log.success("Captured memory snapshot %u", id);
+					return;
+				}
+
+				const u64 prev_id = snapshots.back().id;
+				const std::vector<u32> pages = m_mem_snapshots->get_modified_pages(prev_id, id);
+
+				// Merge contiguous pages into ranges
+				std::string ret;
+
+				for (usz i = 0; i < pages.size();)
+				{
+					usz j = i + 1;
+
+					while (j < pages.size() && pages[j] == pages[j - 1] + 4096)
+					{
+						j++;
+					}
+
+					fmt::append(ret, "\n0x%08x..0x%08x", pages[i], pages[j - 1] + 4095);
+					i = j;
+				}
+
+				gui_log.success("Captured memory snapshot %u, %u pages modified since snapshot %u:%s", id, pages.size(), prev_id, ret);
+				return;
+			}
+
+			if (snapshots.empty() || !m_mem_snapshots->restore(snapshots.back().id))
+			{
+				QMessageBox::warning(this, tr("No memory snapshot"), tr("Capture a memory snapshot with Alt+A first."));
+				return;
+			}
+
+			// Memory contents changed
+			ShowPC();
+			return;
+		}
 		case Qt::Key_N:
 		{
 			// Next instruction according to code flow
@@ -22,6 +22,7 @@ class debugger_list;
 class breakpoint_list;
 class breakpoint_handler;
 class call_stack_list;
+class savestate_ring;
 
 namespace rsx
 {
@@ -92,6 +93,9 @@ class debugger_frame : public custom_dock_widget
 	QDialog* m_goto_dialog = nullptr;
 	QDialog* m_spu_disasm_dialog = nullptr;
 
+	std::shared_ptr<savestate_ring> m_mem_snapshots;
+	u64 m_mem_snapshots_emulation_id = 0;
+
 	std::shared_ptr<gui_settings> m_gui_settings;
 
 	cpu_thread* get_cpu();
@@ -668,7 +668,7 @@ bool game_list_actions::RemoveSPUCache(const std::string& serial, bool is_intera
 	u32 files_removed = 0;
 	u32 files_total = 0;
 
-	const QStringList filter{ QStringLiteral("spu*.dat"), QStringLiteral("spu*.dat.gz"), QStringLiteral("spu*.obj"), QStringLiteral("spu*.obj.gz") };
+	const QStringList filter{ QStringLiteral("spu*.dat"), QStringLiteral("spu*.dat.gz"), QStringLiteral("spu*.dat.idx"), QStringLiteral("spu*.obj"), QStringLiteral("spu*.obj.gz") };
 	const QString q_base_dir = QString::fromStdString(base_dir);
 
 	QDirIterator dir_iter(q_base_dir, filter, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "util/logs.hpp"
+
+#include <mutex>
+
+LOG_CHANNEL(logs_test, "LogsTest");
+
+extern thread_local std::string(*g_tls_log_prefix)();
+extern thread_local logs::prefix_capture g_tls_log_prefix_capture;
+
+namespace logs
+{
+	// Records messages of the test channel
+	struct capture_listener final : listener
+	{
+		std::mutex mutex;
+		std::vector<std::string> lines;
+		bool active = false;
+
+		void log(u64, const message& msg, std::string_view prefix, std::string_view text) override
+		{
+			std::lock_guard lock(mutex);
+
+			if (active && msg->name == std::string_view("LogsTest"))
+			{
+				lines.push_back(fmt::format("%s|%s|%s", level{msg}, prefix, text));
+			}
+		}
+
+		std::vector<std::string> take()
+		{
+			std::lock_guard lock(mutex);
+			return std::exchange(lines, {});
+		}
+	};
+
+	// Prefix provider of the test thread, its state changes between messages
+	static thread_local u64 s_prefix_state = 0;
+
+	static std::string format_test_prefix(const prefix_args& args)
+	{
+		return fmt::format("%s[%u]", args.name, args.values[0]);
+	}
+
+	static void capture_test_prefix(prefix_args& args)
+	{
+		args.format = format_test_prefix;
+		args.name = "Test";
+		args.values[0] = s_prefix_state;
+	}
+
+	static std::string test_prefix()
+	{
+		prefix_args args{};
+		capture_test_prefix(args);
+		return format_test_prefix(args);
+	}
+
+	// Installs the listener and the prefix provider, restores the global logger state afterwards
+	class LogsFixture : public ::testing::Test
+	{
+	protected:
+		capture_listener capture;
+		std::string(*old_prefix)() = nullptr;
+		prefix_capture old_prefix_capture{};
+
+		void SetUp() override
+		{
+			listener::add(&capture);
+			set_init({});
+			logs_test.enabled.release(level::trace);
+
+			old_prefix = std::exchange(g_tls_log_prefix, &test_prefix);
+			old_prefix_capture = std::exchange(g_tls_log_prefix_capture, {&test_prefix, &capture_test_prefix});
+			s_prefix_state = 0;
+
+			capture.active = true;
+		}
+
+		void TearDown() override
+		{
+			capture.active = false;
+
+			set_deferred(false);
+			listener::sync_all();
+
+			g_tls_log_prefix = old_prefix;
+			g_tls_log_prefix_capture = old_prefix_capture;
+
+			logs_test.enabled.release(level::notice);
+			reset_init();
+			listener::remove(&capture);
+		}
+	};
+
+	static void log_samples()
+	{
+		logs_test.notice("int=%d hex=0x%x neg=%d", 42, 0xbeefu, -7);
+		logs_test.trace("float=%g bool=%s", 1.5, true);
+		logs_test.warning("u64=0x%llx level=%s", u64{umax}, level::trace);
+		logs_test.notice("No arguments");
+		logs_test.notice("string=%s", "formatted immediately");
+		logs_test.error("error=%d", 1);
+		logs_test.notice("after error=%d", 2);
+	}
+
+	TEST_F(LogsFixture, DeferredMatchesImmediate)
+	{
+		log_samples();
+		listener::sync_all();
+		const std::vector<std::string> immediate = capture.take();
+
+		set_deferred(true);
+		log_samples();
+		listener::sync_all();
+		set_deferred(false);
+		const std::vector<std::string> deferred = capture.take();
+
+		ASSERT_EQ(immediate.size(), 7u);
+		EXPECT_EQ(deferred, immediate);
+	}
+
+	TEST_F(LogsFixture, DeferredPrefixUsesCallTimeState)
+	{
+		set_deferred(true);
+
+		s_prefix_state = 1;
+		logs_test.notice("first");
+		s_prefix_state = 2;
+		logs_test.notice("second");
+		s_prefix_state = 3;
+
+		listener::sync_all();
+		set_deferred(false);
+
+		const std::vector<std::string> lines = capture.take();
+
+		ASSERT_EQ(lines.size(), 2u);
+		EXPECT_EQ(lines[0], "Notice|Test[1]|first");
+		EXPECT_EQ(lines[1], "Notice|Test[2]|second");
+	}
+}
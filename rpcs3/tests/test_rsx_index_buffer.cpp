@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+
+#include "Emu/RSX/Common/BufferUtils.h"
+
+#include <random>
+#include <vector>
+
+namespace rsx
+{
+	static constexpr primitive_type s_primitive_types[] =
+	{
+		primitive_type::points,
+		primitive_type::lines,
+		primitive_type::line_loop,
+		primitive_type::line_strip,
+		primitive_type::triangles,
+		primitive_type::triangle_strip,
+		primitive_type::triangle_fan,
+		primitive_type::quads,
+		primitive_type::quad_strip,
+		primitive_type::polygon,
+	};
+
+	static const char* get_primitive_name(primitive_type type)
+	{
+		switch (type)
+		{
+		case primitive_type::points: return "points";
+		case primitive_type::lines: return "lines";
+		case primitive_type::line_loop: return "line_loop";
+		case primitive_type::line_strip: return "line_strip";
+		case primitive_type::triangles: return "triangles";
+		case primitive_type::triangle_strip: return "triangle_strip";
+		case primitive_type::triangle_fan: return "triangle_fan";
+		case primitive_type::quads: return "quads";
+		case primitive_type::quad_strip: return "quad_strip";
+		case primitive_type::polygon: return "polygon";
+		}
+
+		return "unknown";
+	}
+
+	static bool expands(primitive_type type)
+	{
+		return !is_primitive_native(type);
+	}
+
+	struct index_result
+	{
+		u32 min_index;
+		u32 max_index;
+		u32 count;
+		std::vector<u32> indices;
+	};
+
+	// Straightforward reimplementation of the expected behaviour
+	template <typename T>
+	static index_result expand_reference(const std::vector<T>& src, primitive_type type, bool restart_enabled, u32 restart_index)
+	{
+		const T invalid_index = static_cast<T>(umax);
+		const auto is_restart = [&](T index) { return restart_enabled && index == restart_index; };
+
+		index_result res{invalid_index, 0, 0, {}};
+
+		const auto use = [&](T index)
+		{
+			res.min_index = std::min<u32>(res.min_index, index);
+			res.max_index = std::max<u32>(res.max_index, index);
+			return index;
+		};
+
+		switch (type)
+		{
+		case primitive_type::triangle_fan:
+		case primitive_type::polygon:
+		{
+			// An outer index equal to the sentinel value needs another one before the next triangle
+			bool needs_anchor = true;
+			T anchor = invalid_index;
+			T last_index = invalid_index;
+
+			for (T index : src)
+			{
+				if (is_restart(index))
+				{
+					needs_anchor = true;
+					last_index = invalid_index;
+				}
+				else if (needs_anchor)
+				{
+					anchor = use(index);
+					needs_anchor = false;
+				}
+				else if (last_index == invalid_index)
+				{
+					last_index = use(index);
+				}
+				else
+				{
+					res.indices.insert(res.indices.end(), {anchor, last_index, use(index)});
+					last_index = index;
+				}
+			}
+
+			break;
+		}
+		case primitive_type::quads:
+		{
+			std::vector<T> quad;
+
+			for (T index : src)
+			{
+				if (is_restart(index))
+				{
+					quad.clear();
+					continue;
+				}
+
+				quad.push_back(use(index));
+
+				if (quad.size() == 4)
+				{
+					res.indices.insert(res.indices.end(), {quad[0], quad[1], quad[2], quad[2], quad[3], quad[0]});
+					quad.clear();
+				}
+			}
+
+			break;
+		}
+		default:
+		{
+			for (T index : src)
+			{
+				if (!is_restart(index))
+				{
+					res.indices.push_back(use(index));
+				}
+				else if (!is_primitive_disjointed(type))
+				{
+					// Kept in place for the host restart
+					res.indices.push_back(invalid_index);
+				}
+			}
+
+			break;
+		}
+		}
+
+		res.count = ::size32(res.indices);
+
+		if (type == primitive_type::line_loop)
+		{
+			res.indices.push_back(src[0]);
+		}
+
+		return res;
+	}
+
+	template <typename T>
+	static index_result expand(const std::vector<T>& src, primitive_type type, bool restart_enabled, u32 restart_index)
+	{
+		const std::vector<be_t<T>> src_be(src.begin(), src.end());
+		std::vector<T> dst(expands(type) ? get_index_count(type, ::size32(src)) : src.size());
+
+		const auto [min_index, max_index, count] = write_index_array_data_to_buffer(
+			{reinterpret_cast<std::byte*>(dst.data()), dst.size() * sizeof(T)},
+			{reinterpret_cast<const std::byte*>(src_be.data()), src_be.size() * sizeof(T)},
+			sizeof(T) == 2 ? index_array_type::u16 : index_array_type::u32,
+			type, restart_enabled, restart_index, expands);
+
+		index_result res{min_index, max_index, count, {}};
+		res.indices.assign(dst.begin(), dst.begin() + count);
+
+		if (type == primitive_type::line_loop)
+		{
+			res.indices.push_back(dst[count]);
+		}
+
+		return res;
+	}
+
+	template <typename T>
+	static std::vector<T> make_indices(std::mt19937& rng, u32 count, u32 restart_rate, T restart_index)
+	{
+		std::vector<T> result(count);
+
+		for (T& index : result)
+		{
+			index = restart_rate && rng() % restart_rate == 0 ? restart_index : static_cast<T>(rng() % 4096);
+		}
+
+		return result;
+	}
+
+	template <typename T>
+	static void fuzz_index_expansion()
+	{
+		std::mt19937 rng(0x1DE5);
+
+		// Sentinel and in-range restart indices, from dense to absent
+		for (const T restart_index : {static_cast<T>(umax), T{7}})
+		{
+			for (u32 restart_rate : {0u, 3u, 17u, 97u})
+			{
+				for (u32 iteration = 0; iteration < 50; iteration++)
+				{
+					// Whole quads, as sized by get_index_count
+					const u32 count = 4 + rng() % 75 * 4;
+					const std::vector<T> src = make_indices<T>(rng, count, restart_rate, restart_index);
+
+					for (primitive_type type : s_primitive_types)
+					{
+						for (bool restart_enabled : {false, true})
+						{
+							const index_result expected = expand_reference(src, type, restart_enabled, restart_index);
+							const index_result result = expand(src, type, restart_enabled, restart_index);
+
+							ASSERT_EQ(result.count, expected.count) << get_primitive_name(type) << " restart=" << restart_enabled << " count=" << count;
+							ASSERT_EQ(result.indices, expected.indices) << get_primitive_name(type) << " restart=" << restart_enabled << " count=" << count;
+
+							// Min/max are only meaningful for non-empty output
+							if (expected.count)
+							{
+								ASSERT_EQ(result.min_index, expected.min_index) << get_primitive_name(type);
+								ASSERT_EQ(result.max_index, expected.max_index) << get_primitive_name(type);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	TEST(IndexBuffer, FuzzU16)
+	{
+		fuzz_index_expansion<u16>();
+	}
+
+	TEST(IndexBuffer, FuzzU32)
+	{
+		fuzz_index_expansion<u32>();
+	}
+
+	TEST(IndexBuffer, RestartOutOfRangeU16)
+	{
+		// 32-bit restart values can never match 16-bit indices
+		const std::vector<u16> src{0, 1, 2, 3, 0xffff, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+		for (primitive_type type : s_primitive_types)
+		{
+			const index_result result = expand<u16>(src, type, true, 0x1ffff);
+			EXPECT_EQ(result.indices, expand_reference<u16>(src, type, false, 0).indices) << get_primitive_name(type);
+		}
+	}
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include "Emu/RSX/Common/texel_converters.h"
+
+#include <random>
+#include <vector>
+
+namespace rsx
+{
+	static constexpr texel_conversion s_conversions[] =
+	{
+		texel_conversion::rgb565_to_bgra8,
+		texel_conversion::argb4_to_bgra8,
+		texel_conversion::a1rgb5_to_bgra8,
+		texel_conversion::rgb5a1_to_bgra8,
+		texel_conversion::rgb655_to_bgra8,
+		texel_conversion::d1rgb5_to_bgra8,
+	};
+
+	static u32 convert_reference(texel_conversion conversion, u16 bits)
+	{
+		switch (conversion)
+		{
+		case texel_conversion::rgb565_to_bgra8: return convert_rgb565_to_bgra8(bits);
+		case texel_conversion::argb4_to_bgra8: return convert_argb4_to_bgra8(bits);
+		case texel_conversion::a1rgb5_to_bgra8: return convert_a1rgb5_to_bgra8(bits);
+		case texel_conversion::rgb5a1_to_bgra8: return convert_rgb5a1_to_bgra8(bits);
+		case texel_conversion::rgb655_to_bgra8: return convert_rgb655_to_bgra8(bits);
+		case texel_conversion::d1rgb5_to_bgra8: return convert_d1rgb5_to_bgra8(bits);
+		}
+
+		return 0;
+	}
+
+	static std::vector<texel_isa> get_supported_isas()
+	{
+		std::vector<texel_isa> result;
+
+		for (texel_isa isa : {texel_isa::scalar, texel_isa::v128, texel_isa::avx2})
+		{
+			if (is_texel_isa_supported(isa))
+			{
+				result.push_back(isa);
+			}
+		}
+
+		return result;
+	}
+
+	TEST(TexelConverters, AllTexels16To32)
+	{
+		// Every 16-bit value, checked against the per-texel reference
+		std::vector<be_t<u16>> src(0x10000);
+		std::vector<u32> dst(src.size());
+
+		for (u32 i = 0; i < src.size(); i++)
+		{
+			src[i] = static_cast<u16>(i);
+		}
+
+		for (texel_isa isa : get_supported_isas())
+		{
+			for (texel_conversion conversion : s_conversions)
+			{
+				get_texel_row_converter(conversion, isa)(dst.data(), src.data(), ::size32(src));
+
+				for (u32 i = 0; i < src.size(); i++)
+				{
+					ASSERT_EQ(dst[i], convert_reference(conversion, static_cast<u16>(i))) << "isa=" << static_cast<u32>(isa) << " conversion=" << static_cast<u32>(conversion) << " texel=" << i;
+				}
+			}
+		}
+	}
+
+	TEST(TexelConverters, FuzzRowLengths)
+	{
+		// Odd lengths and offsets exercise the vector tails and unaligned accesses
+		std::mt19937 rng(0x5EED);
+
+		for (texel_isa isa : get_supported_isas())
+		{
+			for (u32 iteration = 0; iteration < 200; iteration++)
+			{
+				const u32 count = rng() % 80;
+				const u32 offset = rng() % 4;
+
+				std::vector<be_t<u16>> src16(count + offset);
+				std::vector<u32> src32(count + offset);
+
+				for (auto& v : src16)
+					v = static_cast<u16>(rng());
+				for (auto& v : src32)
+					v = static_cast<u32>(rng());
+
+				for (texel_conversion conversion : s_conversions)
+				{
+					// Guard texel past the end must stay untouched
+					std::vector<u32> dst(count + 1, 0xCDCDCDCD);
+					get_texel_row_converter(conversion, isa)(dst.data(), src16.data() + offset, count);
+
+					for (u32 i = 0; i < count; i++)
+					{
+						ASSERT_EQ(dst[i], convert_reference(conversion, src16[offset + i]));
+					}
+
+					ASSERT_EQ(dst[count], 0xCDCDCDCD);
+				}
+
+				{
+					std::vector<u16> dst(count + 1, 0xCDCD);
+					get_rgb655_to_rgb565_row_converter(isa)(dst.data(), src16.data() + offset, count);
+
+					for (u32 i = 0; i < count; i++)
+					{
+						ASSERT_EQ(dst[i], convert_rgb655_to_rgb565(src16[offset + i]));
+					}
+
+					ASSERT_EQ(dst[count], 0xCDCD);
+				}
+
+				for (bool swap_words : {false, true})
+				{
+					std::vector<u32> expected(count * 2 + 1, 0xCDCDCDCD);
+					std::vector<u32> dst(count * 2 + 1, 0xCDCDCDCD);
+
+					get_rb_rg_row_converter(swap_words, texel_isa::scalar)(expected.data(), src32.data() + offset, count);
+					get_rb_rg_row_converter(swap_words, isa)(dst.data(), src32.data() + offset, count);
+
+					ASSERT_EQ(dst, expected) << "isa=" << static_cast<u32>(isa) << " swap_words=" << swap_words;
+				}
+			}
+		}
+	}
+
+	TEST(TexelConverters, RbRgReference)
+	{
+		const u32 block = 0x44332211;
+		u32 dst[2]{};
+
+		// RB_RG: R0=0x11 B=0x22 R1=0x33 G=0x44
+		get_rb_rg_row_converter(false, texel_isa::scalar)(dst, &block, 1);
+		EXPECT_EQ(dst[0], 0xFF114422u);
+		EXPECT_EQ(dst[1], 0xFF334422u);
+
+		// BR_GR: B=0x11 R0=0x22 G=0x33 R1=0x44
+		get_rb_rg_row_converter(true, texel_isa::scalar)(dst, &block, 1);
+		EXPECT_EQ(dst[0], 0xFF223311u);
+		EXPECT_EQ(dst[1], 0xFF443311u);
+	}
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "Emu/savestate_ring.hpp"
+#include "util/types.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct test_memory
+	{
+		// Two regions: 8 pages at 0x10000 and 3 pages at 0x30000
+		std::vector<u8> first = std::vector<u8>(8 * 4096);
+		std::vector<u8> second = std::vector<u8>(3 * 4096);
+		u32 seed = 1;
+
+		std::vector<savestate_ring::memory_region> regions()
+		{
+			return {{0x10000, first.data(), first.size()}, {0x30000, second.data(), second.size()}};
+		}
+
+		void fill_page(std::vector<u8>& region, usz page)
+		{
+			for (usz i = page * 4096; i < (page + 1) * 4096; i++)
+			{
+				seed = seed * 1103515245 + 12345;
+				region[i] = static_cast<u8>(seed >> 16);
+			}
+		}
+
+		void fill_all()
+		{
+			for (usz i = 0; i < 8; i++) fill_page(first, i);
+			for (usz i = 0; i < 3; i++) fill_page(second, i);
+		}
+
+		std::vector<u8> copy() const
+		{
+			std::vector<u8> result = first;
+			result.insert(result.end(), second.begin(), second.end());
+			return result;
+		}
+	};
+
+	bool wait_for_compression(savestate_ring& ring)
+	{
+		for (u32 i = 0; i < 500; i++)
+		{
+			bool done = true;
+
+			for (const auto& info : ring.get_snapshots())
+			{
+				done = done && info.compressed_size != 0;
+			}
+
+			if (done)
+			{
+				return true;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		return false;
+	}
+}
+
+TEST(SavestateRing, RoundTripAcrossKeyAndDeltas)
+{
+	test_memory mem;
+	mem.fill_all();
+
+	// A key snapshot every 3 snapshots: 1 (key), 2, 3, 4 (key), 5
+	savestate_ring ring(64, 3);
+
+	std::vector<std::vector<u8>> expected;
+	std::vector<u64> ids;
+
+	for (u32 i = 0; i < 5; i++)
+	{
+		if (i)
+		{
+			mem.fill_page(mem.first, i);
+			mem.fill_page(mem.second, i % 3);
+		}
+
+		ids.push_back(ring.capture(mem.regions()));
+		expected.push_back(mem.copy());
+	}
+
+	const auto infos = ring.get_snapshots();
+	ASSERT_EQ(infos.size(), 5u);
+	EXPECT_TRUE(infos[0].is_key);
+	EXPECT_FALSE(infos[1].is_key);
+	EXPECT_FALSE(infos[2].is_key);
+	EXPECT_TRUE(infos[3].is_key);
+	EXPECT_FALSE(infos[4].is_key);
+
+	// Deltas only store the two modified pages
+	EXPECT_LT(infos[1].raw_size, infos[0].raw_size / 4);
+
+	EXPECT_EQ(ring.get_modified_pages(ids[0], ids[1]), (std::vector<u32>{0x11000, 0x31000}));
+
+	// Restore out of order from scrambled memory, once before and once after compression
+	for (u32 pass = 0; pass < 2; pass++)
+	{
+		if (pass)
+		{
+			ASSERT_TRUE(wait_for_compression(ring));
+		}
+
+		for (usz index : {4, 1, 3, 0, 2})
+		{
+			mem.fill_all();
+			ASSERT_TRUE(ring.restore(ids[index], mem.regions()));
+			EXPECT_EQ(mem.copy(), expected[index]) << "snapshot " << ids[index] << " pass " << pass;
+		}
+	}
+
+	// Memory no longer matches the last snapshot after a restore, the next one must be a key
+	mem.fill_page(mem.first, 7);
+	ring.capture(mem.regions());
+	EXPECT_TRUE(ring.get_snapshots().back().is_key);
+}
+
+TEST(SavestateRing, RemovesOldestGroup)
+{
+	test_memory mem;
+	mem.fill_all();
+
+	savestate_ring ring(4, 2);
+
+	std::vector<u64> ids;
+
+	for (u32 i = 0; i < 6; i++)
+	{
+		mem.fill_page(mem.first, i);
+		ids.push_back(ring.capture(mem.regions()));
+	}
+
+	const std::vector<u8> last = mem.copy();
+
+	// The group of snapshots 1 and 2 has been removed with its key
+	const auto infos = ring.get_snapshots();
+	ASSERT_EQ(infos.size(), 4u);
+	EXPECT_EQ(infos.front().id, ids[2]);
+	EXPECT_TRUE(infos.front().is_key);
+
+	EXPECT_FALSE(ring.restore(ids[0], mem.regions()));
+
+	mem.fill_all();
+	ASSERT_TRUE(ring.restore(ids[5], mem.regions()));
+	EXPECT_EQ(mem.copy(), last);
+}
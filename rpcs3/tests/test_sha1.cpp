@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "Crypto/sha1.h"
+#include "util/types.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	std::vector<u8> make_data(usz size, u32 seed)
+	{
+		std::vector<u8> data(size);
+
+		for (u8& byte : data)
+		{
+			seed = seed * 1103515245 + 12345;
+			byte = static_cast<u8>(seed >> 16);
+		}
+
+		return data;
+	}
+}
+
+TEST(SHA1, KnownAnswer)
+{
+	const u8 expected[20] =
+	{
+		0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e,
+		0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c, 0x9c, 0xd0, 0xd8, 0x9d,
+	};
+
+	u8 output[20]{};
+	sha1(reinterpret_cast<const u8*>("abc"), 3, output);
+
+	EXPECT_EQ(std::memcmp(output, expected, sizeof(output)), 0);
+}
+
+TEST(SHA1, MultiMatchesSingle)
+{
+	for (usz size : {0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 4097})
+	{
+		// Not a multiple of the lane count
+		std::vector<std::vector<u8>> inputs;
+		std::vector<const u8*> ptrs;
+
+		for (u32 i = 0; i < 13; i++)
+		{
+			inputs.push_back(make_data(size, i));
+			ptrs.push_back(inputs.back().data());
+		}
+
+		std::vector<u8> multi(inputs.size() * 20);
+		sha1_multi(ptrs.data(), size, reinterpret_cast<u8(*)[20]>(multi.data()), ptrs.size());
+
+		for (usz i = 0; i < inputs.size(); i++)
+		{
+			u8 single[20];
+			sha1(ptrs[i], size, single);
+
+			EXPECT_EQ(std::memcmp(single, multi.data() + i * 20, 20), 0) << "size=" << size << " index=" << i;
+		}
+	}
+}
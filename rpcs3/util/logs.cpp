@@ -40,6 +40,9 @@ static std::string default_string()
 // Thread-specific log prefix provider
 thread_local std::string(*g_tls_log_prefix)() = &default_string;
 
+// Thread-specific deferred form of g_tls_log_prefix (optional)
+thread_local logs::prefix_capture g_tls_log_prefix_capture{};
+
 // Another thread-specific callback
 thread_local void(*g_tls_log_control)(const char* fmt, u64 progress) = [](const char*, u64){};
 
@@ -196,6 +199,87 @@ namespace logs
 	// Must be set to true in main()
 	static atomic_t<bool> g_init{false};
 
+	// Deferred message ring size (power of 2)
+	constexpr u64 s_deferred_count = 16384;
+
+	// Message queued by message::defer, formatted by drain_deferred()
+	struct deferred_record
+	{
+		// Equals the push position when free, push position + 1 when ready
+		atomic_t<u64> seq{0};
+
+		const message* msg{};
+		const char* fmt{};
+		const fmt_type_info* sup{};
+		u64 stamp{};
+		u64 args[max_deferred_args]{};
+		std::string prefix; // Used when prefix_inputs.format is not set
+
+		// Strings keep their capacity when the record is reused
+		prefix_args prefix_inputs{};
+		std::string prefix_name;
+		std::string prefix_module;
+	};
+
+	static atomic_t<bool> g_deferred{false};
+	static atomic_t<bool> g_deferred_ready{false}; // Set once g_deferred_records is allocated
+	static std::unique_ptr<deferred_record[]> g_deferred_records;
+	static atomic_t<u64> g_deferred_push{0};
+	static atomic_t<u64> g_deferred_pop{0}; // Modified under g_deferred_mutex
+	static shared_mutex g_deferred_mutex;
+
+	// Incremented to wake up the log writer thread early
+	static atomic_t<u32> g_deferred_signal{0};
+
+	// Set while the current thread sends deferred messages (listeners may log themselves)
+	static thread_local bool s_tls_draining = false;
+
+	// Push position past the last message deferred by the current thread
+	static thread_local u64 s_tls_deferred_end = 0;
+
+	// Format queued messages and send them to listeners, returns true if anything was sent
+	static bool drain_deferred()
+	{
+		if (!g_deferred_ready || s_tls_draining)
+		{
+			return false;
+		}
+
+		std::lock_guard lock(g_deferred_mutex);
+
+		s_tls_draining = true;
+
+		static constexpr fmt_type_info empty_sup{};
+
+		bool result = false;
+
+		while (true)
+		{
+			const u64 pos = g_deferred_pop;
+			deferred_record& record = g_deferred_records[pos % s_deferred_count];
+
+			if (record.seq.load() != pos + 1)
+			{
+				// Empty, or the next message is still being written
+				break;
+			}
+
+			std::string prefix = record.prefix_inputs.format ? record.prefix_inputs.format(record.prefix_inputs) : std::move(record.prefix);
+
+			stored_message msg{*record.msg, record.stamp, std::move(prefix), {}};
+			fmt::raw_append(msg.text, record.fmt, record.sup ? record.sup : &empty_sup, record.args);
+
+			record.seq.release(pos + s_deferred_count);
+			g_deferred_pop.release(pos + 1);
+
+			get_logger()->broadcast(msg);
+			result = true;
+		}
+
+		s_tls_draining = false;
+		return result;
+	}
+
 	void reset()
 	{
 		std::lock_guard lock(g_mutex);
@@ -271,6 +355,34 @@ namespace logs
 		}
 	}
 
+	void set_deferred(bool enabled)
+	{
+		if (enabled && !g_deferred_ready)
+		{
+			std::lock_guard lock(g_mutex);
+
+			if (!g_deferred_ready)
+			{
+				auto records = std::make_unique<deferred_record[]>(s_deferred_count);
+
+				for (u64 i = 0; i < s_deferred_count; i++)
+				{
+					records[i].seq.release(i);
+				}
+
+				g_deferred_records = std::move(records);
+				g_deferred_ready.release(true);
+			}
+		}
+
+		g_deferred.release(enabled);
+
+		if (!enabled)
+		{
+			drain_deferred();
+		}
+	}
+
 	std::vector<std::string> get_channels()
 	{
 		std::vector<std::string> result;
@@ -313,6 +425,12 @@ namespace logs
 			g_init = true;
 		}
 	}
+
+	void reset_init()
+	{
+		std::lock_guard lock(g_mutex);
+		g_init = false;
+	}
 }
 
 logs::listener::~listener()
@@ -349,6 +467,23 @@ void logs::listener::add(logs::listener* _new)
 	}
 }
 
+void logs::listener::remove(logs::listener* _old)
+{
+	listener* lis = get_logger();
+
+	std::lock_guard lock(g_mutex);
+
+	for (; lis; lis = lis->m_next)
+	{
+		if (lis->m_next == _old)
+		{
+			lis->m_next.release(_old->m_next.load());
+			_old->m_next.release(nullptr);
+			break;
+		}
+	}
+}
+
 void logs::listener::broadcast(const logs::stored_message& msg) const
 {
 	for (auto lis = m_next.load(); lis; lis = lis->m_next)
@@ -367,6 +502,8 @@ void logs::listener::close_prematurely()
 
 void logs::listener::sync_all()
 {
+	drain_deferred();
+
 	for (listener* lis = get_logger(); lis; lis = lis->m_next)
 	{
 		lis->sync();
@@ -388,6 +525,92 @@ logs::registerer::registerer(channel& _ch)
 	get_logger()->channels.emplace(_ch.name, &_ch);
 }
 
+bool logs::message::defer(const char* fmt, const fmt_type_info* sup, const u64* args, usz args_count) const
+{
+	// Errors and above stay synchronous, they may need immediate attention
+	if (*this < level::warning || !g_deferred || !g_init)
+	{
+		return false;
+	}
+
+	// Reserve a record
+	u64 pos = g_deferred_push;
+	deferred_record* record = nullptr;
+
+	while (true)
+	{
+		record = &g_deferred_records[pos % s_deferred_count];
+
+		const u64 seq = record->seq.load();
+
+		if (seq == pos)
+		{
+			if (g_deferred_push.compare_exchange(pos, pos + 1))
+			{
+				break;
+			}
+		}
+		else if (seq < pos)
+		{
+			// Queue is full, make space (the oldest message may still be written by another thread)
+			if (!drain_deferred())
+			{
+				if (s_tls_draining)
+				{
+					return false;
+				}
+
+				std::this_thread::yield();
+			}
+
+			pos = g_deferred_push;
+		}
+		else
+		{
+			pos = g_deferred_push;
+		}
+	}
+
+	g_tls_log_control(fmt, 0);
+
+	record->msg = this;
+	record->fmt = fmt;
+	record->sup = sup;
+	record->stamp = get_stamp();
+	std::copy_n(args, args_count, record->args);
+
+	// The prefix depends on the current state of the thread, only its inputs can be deferred
+	if (g_tls_log_prefix_capture.capture && g_tls_log_prefix_capture.prefix == g_tls_log_prefix)
+	{
+		prefix_args inputs{};
+		g_tls_log_prefix_capture.capture(inputs);
+
+		record->prefix_name.assign(inputs.name);
+		record->prefix_module.assign(inputs.module);
+		inputs.name = record->prefix_name;
+		inputs.module = record->prefix_module;
+		record->prefix_inputs = inputs;
+	}
+	else
+	{
+		record->prefix_inputs.format = nullptr;
+		record->prefix = g_tls_log_prefix();
+	}
+
+	record->seq.release(pos + 1);
+	s_tls_deferred_end = pos + 1;
+
+	if (pos % (s_deferred_count / 4) == 0)
+	{
+		// Wake up the log writer thread
+		g_deferred_signal++;
+		g_deferred_signal.notify_one();
+	}
+
+	g_tls_log_control(fmt, -1);
+	return true;
+}
+
 void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) const
 {
 	// Get timestamp
@@ -396,6 +619,15 @@ void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) co
 	// Notify start operation
 	g_tls_log_control(fmt, 0);
 
+	// Send messages deferred by this thread first to keep the order
+	while (g_deferred_pop < s_tls_deferred_end && !s_tls_draining)
+	{
+		if (!drain_deferred())
+		{
+			std::this_thread::yield();
+		}
+	}
+
 	// Get text, extract va_args
 	thread_local std::string text;
 	thread_local std::vector<u64> args;
@@ -501,6 +733,11 @@ logs::file_writer::file_writer(const std::string& name, u64 max_size)
 
 		while (true)
 		{
+			const u32 signal = g_deferred_signal;
+
+			// Format deferred messages
+			drain_deferred();
+
 			const u64 bufv = m_buf;
 
 			if (bufv % s_log_size)
@@ -517,7 +754,7 @@ logs::file_writer::file_writer(const std::string& name, u64 max_size)
 					break;
 				}
 
-				std::this_thread::sleep_for(10ms);
+				g_deferred_signal.wait(signal, atomic_wait_timeout{10'000'000});
 			}
 		}
 	});
@@ -24,6 +24,13 @@ namespace logs
 
 	struct channel;
 
+	// Maximal number of arguments of a deferred message
+	constexpr usz max_deferred_args = 8;
+
+	// Arguments passed by value, which can be formatted later on another thread
+	template <typename T>
+	concept deferrable_arg = (std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_enum_v<T>) && sizeof(T) <= 8;
+
 	// Message information
 	struct message
 	{
@@ -55,6 +62,9 @@ namespace logs
 		// Send log message to global logger instance
 		void broadcast(const char*, const fmt_type_info*, ...) const;
 
+		// Queue log message for formatting on the log writer thread (returns false if not queued)
+		bool defer(const char*, const fmt_type_info*, const u64*, usz) const;
+
 		friend struct channel;
 	};
 
@@ -66,6 +76,22 @@ namespace logs
 		std::string text;
 	};
 
+	// Inputs of the log prefix of a thread, captured when a message is deferred and formatted on the log writer thread
+	struct prefix_args
+	{
+		std::string(*format)(const prefix_args&) = nullptr;
+		std::string_view name; // Copied when captured
+		std::string_view module; // Copied when captured
+		u64 values[4]{};
+	};
+
+	// Deferred form of a log prefix provider (see g_tls_log_prefix_capture)
+	struct prefix_capture
+	{
+		std::string(*prefix)() = nullptr; // Only used while g_tls_log_prefix equals it
+		void(*capture)(prefix_args&) = nullptr;
+	};
+
 	class listener
 	{
 		// Next listener (linked list)
@@ -90,6 +116,9 @@ namespace logs
 		// Add new listener
 		static void add(listener*);
 
+		// Remove listener (messages must not be sent meanwhile)
+		static void remove(listener*);
+
 		// Special purpose
 		void broadcast(const stored_message&) const;
 
@@ -149,11 +178,24 @@ namespace logs
 		{
 			if constexpr (sizeof...(Args) > 0)
 			{
+				if constexpr (sizeof...(Args) <= max_deferred_args && (deferrable_arg<fmt_unveil_t<Args>> && ...))
+				{
+					const u64 values[]{u64{fmt_unveil<Args>::get(args)}...};
+
+					if (defer(fmt, fmt::type_info_v<Args...>, values, sizeof...(Args)))
+					{
+						return;
+					}
+				}
+
 				broadcast(fmt, fmt::type_info_v<Args...>, u64{fmt_unveil<Args>::get(args)}...);
 			}
 			else
 			{
-				broadcast(fmt, nullptr);
+				if (!defer(fmt, nullptr, nullptr, 0))
+				{
+					broadcast(fmt, nullptr);
+				}
 			}
 		}
 	}
@@ -178,6 +220,10 @@ namespace logs
 	// Log level control: set specific channels to level::fatal
 	void set_channel_levels(const std::map<std::string, logs::level, std::less<>>& map);
 
+	// Log mode control: format warning, notice and trace messages with value arguments on the log writer thread
+	// Messages are delivered to listeners later, in order; format strings must be string literals
+	void set_deferred(bool enabled);
+
 	// Get all registered log channels
 	std::vector<std::string> get_channels();
 
@@ -192,6 +238,9 @@ namespace logs
 
 	// Called in main()
 	void set_init(std::initializer_list<stored_message>);
+
+	// Undo set_init, messages are stored again until the next call (used by tests)
+	void reset_init();
 }
 
 #define LOG_CHANNEL(ch, ...) inline constinit ::logs::channel ch(::logs::make_channel_name(#ch, ##__VA_ARGS__)); \
@@ -327,6 +327,17 @@ bool utils::has_clwb()
 #endif
 }
 
+bool utils::has_sha_ni()
+{
+#if defined(ARCH_X64)
+	// Check SHA extensions (SHA-1 and SHA-256 instructions)
+	static const bool g_value = get_cpuid(0, 0)[0] >= 0x7 && (get_cpuid(7, 0)[1] & 0x20000000) == 0x20000000 && has_sse41();
+	return g_value;
+#else
+	return false;
+#endif
+}
+
 bool utils::has_invariant_tsc()
 {
 #if defined(ARCH_X64)